@@ -0,0 +1,108 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchData.h"
+#include <algorithm>
+#include <random>
+#include <unordered_set>
+
+namespace BenchData {
+std::vector<uint32> MakeEntries(std::size_t count, uint32 seed) {
+  std::mt19937 rng(seed);
+  std::unordered_set<uint32> seen;
+  std::vector<uint32> entries;
+  entries.reserve(count);
+  while (entries.size() < count) {
+    uint32 entry = rng() % 2000000 + 1;
+    if (seen.insert(entry).second)
+      entries.push_back(entry);
+  }
+  return entries;
+}
+
+static std::string MakeWord(std::mt19937 &rng, uint32 minLength,
+                            uint32 maxLength) {
+  std::string word(minLength + rng() % (maxLength - minLength + 1), 'a');
+  for (char &c : word)
+    c = char('a' + rng() % 26);
+  return word;
+}
+
+std::vector<std::string> MakeNames(std::size_t count, uint32 seed) {
+  std::mt19937 rng(seed);
+  std::vector<std::string> names;
+  names.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    std::string name;
+    for (uint32 words = 1 + rng() % 3; words; --words) {
+      std::string word = MakeWord(rng, 3, 9);
+      word[0] = char(word[0] - 'a' + 'A');
+      name += name.empty() ? word : " " + word;
+    }
+    names.push_back(std::move(name));
+  }
+  return names;
+}
+
+std::vector<std::string> MakeWords(std::size_t count, uint32 seed) {
+  std::mt19937 rng(seed);
+  std::vector<std::string> words;
+  words.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+    words.push_back(MakeWord(rng, 4, 9));
+  return words;
+}
+
+std::vector<std::string> MakeNameCandidates(std::size_t count, uint32 seed) {
+  static char const *const Separators[] = {" ", "-", "'", "  ", "--", "4"};
+
+  std::mt19937 rng(seed);
+  std::vector<std::string> names;
+  names.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    std::string name = MakeWord(rng, 2, 8);
+    name[0] = char(name[0] - 'a' + 'A');
+    if (rng() % 2)
+      name += Separators[rng() % std::size(Separators)] + MakeWord(rng, 2, 8);
+    if (rng() % 10 == 0)
+      name = " " + name;
+    names.push_back(std::move(name));
+  }
+  return names;
+}
+
+std::shared_ptr<BeastmasterCatalog> MakeCatalog(std::size_t count) {
+  // Roughly the shipped split: mostly normal pets, a sixth exotic and a
+  // handful of rare ones.
+  std::vector<uint32> entries = MakeEntries(count);
+  std::vector<std::string> names = MakeNames(count);
+  auto catalog = std::make_shared<BeastmasterCatalog>(1);
+  for (std::size_t i = 0; i < count; ++i) {
+    bool exotic = i % 6 == 0;
+    bool rare = i % 100 == 0;
+    BeastmasterPetCategory category =
+        rare ? (exotic ? PET_CATEGORY_RARE_EXOTIC : PET_CATEGORY_RARE)
+             : (exotic ? PET_CATEGORY_EXOTIC : PET_CATEGORY_NORMAL);
+    catalog->Add(entries[i], names[i], 1 + uint32(i % 46),
+                 exotic ? PET_RARITY_EXOTIC : PET_RARITY_NORMAL,
+                 i % 3 ? 3 : 1, category);
+  }
+  catalog->Finalize();
+  return catalog;
+}
+} // namespace BenchData
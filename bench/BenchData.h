@@ -0,0 +1,50 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_BENCH_DATA_H_
+#define _BEASTMASTER_BENCH_DATA_H_
+
+#include "BeastmasterCatalog.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Deterministic inputs shared by the benchmarks, so runs on different
+ * machines or commits measure the same data.
+ */
+namespace BenchData {
+// Distinct creature entries in random order.
+std::vector<uint32> MakeEntries(std::size_t count, uint32 seed = 42);
+
+// Pet names of one to three capitalized words, e.g. "Bloodaxe Worg Pup".
+std::vector<std::string> MakeNames(std::size_t count, uint32 seed = 42);
+
+// Lower case words of 4 to 9 letters.
+std::vector<std::string> MakeWords(std::size_t count, uint32 seed = 42);
+
+// Name candidates as players type them: mostly valid, some with digits,
+// doubled separators, bad edges or the wrong length.
+std::vector<std::string> MakeNameCandidates(std::size_t count,
+                                            uint32 seed = 42);
+
+// A finalized catalog with the category mix of the shipped tames.
+std::shared_ptr<BeastmasterCatalog> MakeCatalog(std::size_t count);
+} // namespace BenchData
+
+#endif // _BEASTMASTER_BENCH_DATA_H_
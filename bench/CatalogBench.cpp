@@ -0,0 +1,120 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterCatalog.h"
+#include "BeastmasterCatalogFile.h"
+#include "BenchData.h"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+// The catalog row before it was split into columns.
+struct LegacyPetInfo {
+  uint32 entry;
+  std::string name;
+  uint32 family;
+  std::string rarity;
+  uint32 icon;
+};
+
+void CatalogSizes(benchmark::internal::Benchmark *b) {
+  for (int64 pets : {1000, 5000, 10000, 50000})
+    b->Arg(pets);
+}
+
+// Add() and Finalize() of every row, including the perfect hash index.
+void BM_CatalogBuild(benchmark::State &state) {
+  std::size_t count = std::size_t(state.range(0));
+  std::vector<uint32> entries = BenchData::MakeEntries(count);
+  std::vector<std::string> names = BenchData::MakeNames(count);
+
+  std::size_t bytes = 0;
+  std::size_t legacyBytes = 0;
+  for (auto _ : state) {
+    BeastmasterCatalog catalog;
+    for (std::size_t i = 0; i < count; ++i)
+      catalog.Add(entries[i], names[i], 1, PET_RARITY_NORMAL, 3,
+                  PET_CATEGORY_NORMAL);
+    catalog.Finalize();
+    bytes = catalog.GetMemoryUsage();
+    legacyBytes = catalog.EstimateLegacyMemoryUsage();
+  }
+  state.counters["bytes"] = double(bytes);
+  state.counters["legacy_bytes"] = double(legacyBytes);
+}
+BENCHMARK(BM_CatalogBuild)->Apply(CatalogSizes)->Unit(benchmark::kMillisecond);
+
+void BM_CatalogFind(benchmark::State &state) {
+  std::size_t count = std::size_t(state.range(0));
+  auto catalog = BenchData::MakeCatalog(count);
+  std::vector<uint32> lookups = BenchData::MakeEntries(count);
+
+  std::size_t i = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(catalog->FindRow(lookups[i++ % count]));
+}
+BENCHMARK(BM_CatalogFind)->Apply(CatalogSizes);
+
+// The lookup the perfect hash replaced: a locked unordered_map of rows.
+void BM_LegacyCatalogFind(benchmark::State &state) {
+  std::size_t count = std::size_t(state.range(0));
+  std::vector<uint32> entries = BenchData::MakeEntries(count);
+  std::vector<std::string> names = BenchData::MakeNames(count);
+  std::unordered_map<uint32, LegacyPetInfo> pets;
+  for (std::size_t i = 0; i < count; ++i)
+    pets[entries[i]] = {entries[i], names[i], 1, "normal", 3};
+  std::mutex lock;
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    std::lock_guard<std::mutex> guard(lock);
+    benchmark::DoNotOptimize(pets.find(entries[i++ % count]));
+  }
+}
+BENCHMARK(BM_LegacyCatalogFind)->Apply(CatalogSizes);
+
+// Maps and verifies a saved catalog, the warm start path.
+void BM_CatalogFileRead(benchmark::State &state) {
+  std::size_t count = std::size_t(state.range(0));
+  auto catalog = BenchData::MakeCatalog(count);
+  std::string path = (std::filesystem::temp_directory_path() /
+                      ("beastmaster_bench_" + std::to_string(count) + ".bin"))
+                         .string();
+  BeastmasterCatalogKey key{count, 1, 2, 3};
+  if (!BeastmasterCatalogFile::Write(path, *catalog, key)) {
+    state.SkipWithError("cannot write the catalog file");
+    return;
+  }
+
+  std::string error;
+  for (auto _ : state) {
+    auto mapped = BeastmasterCatalogFile::Read(path, key, 1, error);
+    if (!mapped) {
+      state.SkipWithError(error.c_str());
+      break;
+    }
+    benchmark::DoNotOptimize(mapped->FindRow(1));
+  }
+  std::filesystem::remove(path);
+}
+BENCHMARK(BM_CatalogFileRead)
+    ->Apply(CatalogSizes)
+    ->Unit(benchmark::kMillisecond);
+} // namespace
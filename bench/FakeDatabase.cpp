@@ -0,0 +1,103 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FakeDatabase.h"
+#include <algorithm>
+
+FakeDatabase::FakeDatabase(uint32 connections,
+                           std::chrono::microseconds latency,
+                           std::chrono::microseconds jitter)
+    : _latency(latency), _jitter(jitter) {
+  for (uint32 i = 0; i < connections; ++i)
+    _connections.emplace_back(&FakeDatabase::Work, this, i);
+}
+
+void FakeDatabase::Execute(std::function<void(Table &)> statement) {
+  Queue([this, statement = std::move(statement)]() {
+    std::lock_guard<BeastmasterMutex> lock(_tableLock);
+    statement(_table);
+  });
+}
+
+void FakeDatabase::AsyncQuery(uint64 owner, std::size_t limit,
+                              std::function<void(std::vector<Row>)> callback) {
+  Queue([this, owner, limit, callback = std::move(callback)]() {
+    std::vector<Row> rows;
+    {
+      std::lock_guard<BeastmasterMutex> lock(_tableLock);
+      auto it = _table.find(owner);
+      if (it != _table.end())
+        rows.assign(it->second.begin(),
+                    it->second.begin() +
+                        std::min(limit, it->second.size()));
+    }
+    callback(std::move(rows));
+  });
+}
+
+void FakeDatabase::Stop() {
+  {
+    std::lock_guard<BeastmasterMutex> lock(_queueLock);
+    _stopping = true;
+    _dropped += _queue.size();
+    _queue.clear();
+  }
+  _queueChanged.notify_all();
+  for (std::thread &connection : _connections)
+    connection.join();
+  _connections.clear();
+}
+
+double FakeDatabase::GetAverageQueueWaitMs() const {
+  if (!_statements)
+    return 0.0;
+  return std::chrono::duration<double, std::milli>(_queueWait).count() /
+         double(_statements);
+}
+
+void FakeDatabase::Queue(std::function<void()> run) {
+  {
+    std::lock_guard<BeastmasterMutex> lock(_queueLock);
+    _queue.push_back({std::chrono::steady_clock::now(), std::move(run)});
+  }
+  _queueChanged.notify_one();
+}
+
+void FakeDatabase::Work(uint32 seed) {
+  std::mt19937 rng(seed);
+  for (;;) {
+    Task task;
+    {
+      std::unique_lock<BeastmasterMutex> lock(_queueLock);
+      _queueChanged.wait(lock,
+                         [this]() { return _stopping || !_queue.empty(); });
+      if (_queue.empty())
+        return;
+      task = std::move(_queue.front());
+      _queue.pop_front();
+      ++_statements;
+      _queueWait += std::chrono::steady_clock::now() - task.queued;
+    }
+
+    auto delay = _latency;
+    if (_jitter.count())
+      delay += std::chrono::microseconds(rng() % (_jitter.count() + 1));
+    std::this_thread::sleep_for(delay);
+    task.run();
+  }
+}
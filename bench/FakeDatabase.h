@@ -0,0 +1,100 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_FAKE_DATABASE_H_
+#define _BEASTMASTER_FAKE_DATABASE_H_
+
+#include "BeastmasterDefines.h"
+#include "BeastmasterMutex.h"
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * FakeDatabase
+ * In-process stand-in for the character database: one beastmaster_tamed_pets
+ * table and a pool of connection threads. Every statement waits for the
+ * configured latency (plus uniform jitter) on its connection before it runs,
+ * so queries queue up the way they do against a busy server.
+ */
+class FakeDatabase {
+public:
+  struct Row {
+    uint32 entry;
+    std::string name;
+    time_t tamedAt;
+  };
+
+  using Table = std::unordered_map<uint64, std::vector<Row>>;
+
+  FakeDatabase(uint32 connections, std::chrono::microseconds latency,
+               std::chrono::microseconds jitter);
+  ~FakeDatabase() { Stop(); }
+
+  // Queues a write against the table.
+  void Execute(std::function<void(Table &)> statement);
+
+  // Queues a read of the owner's newest rows, at most limit of them; the
+  // callback runs on a connection thread with a copy of them.
+  void AsyncQuery(uint64 owner, std::size_t limit,
+                  std::function<void(std::vector<Row>)> callback);
+
+  // Drops what is still queued and joins the connection threads.
+  void Stop();
+
+  uint64 GetStatementCount() const { return _statements; }
+  uint64 GetDroppedCount() const { return _dropped; }
+  double GetAverageQueueWaitMs() const;
+
+  BeastmasterLockStats queueLockStats;
+  BeastmasterLockStats tableLockStats;
+
+private:
+  struct Task {
+    std::chrono::steady_clock::time_point queued;
+    std::function<void()> run;
+  };
+
+  void Queue(std::function<void()> run);
+  void Work(uint32 seed);
+
+  std::chrono::microseconds _latency;
+  std::chrono::microseconds _jitter;
+
+  BeastmasterMutex _queueLock{queueLockStats};
+  std::condition_variable_any _queueChanged;
+  std::deque<Task> _queue;
+  bool _stopping = false;
+  uint64 _statements = 0;
+  uint64 _dropped = 0;
+  std::chrono::nanoseconds _queueWait{0};
+
+  BeastmasterMutex _tableLock{tableLockStats};
+  Table _table;
+
+  std::vector<std::thread> _connections;
+};
+
+#endif // _BEASTMASTER_FAKE_DATABASE_H_
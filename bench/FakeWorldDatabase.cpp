@@ -0,0 +1,56 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FakeWorldDatabase.h"
+#include "BenchData.h"
+#include <thread>
+
+FakeWorldDatabase::FakeWorldDatabase(std::size_t tames,
+                                     std::chrono::microseconds latency,
+                                     std::chrono::nanoseconds perRow)
+    : _latency(latency), _perRow(perRow) {
+  // The category mix of BenchData::MakeCatalog(), before validation.
+  std::vector<uint32> entries = BenchData::MakeEntries(tames);
+  std::vector<std::string> names = BenchData::MakeNames(tames);
+  _tames.reserve(tames);
+  for (std::size_t i = 0; i < tames; ++i) {
+    bool exotic = i % 6 == 0;
+    BeastmasterTameRow &row = _tames.emplace_back();
+    row.entry = entries[i];
+    row.name = names[i];
+    row.family = 1 + uint32(i % 46);
+    row.rarity = exotic ? PET_RARITY_EXOTIC : PET_RARITY_NORMAL;
+    row.typeFlags = CREATURE_TEMPLATE_TAMEABLE |
+                    (exotic ? CREATURE_TEMPLATE_EXOTIC_PET : 0);
+
+    if (i % 53 == 7)
+      row.typeFlags.reset();
+    else if (i % 59 == 11)
+      *row.typeFlags &= ~CREATURE_TEMPLATE_TAMEABLE;
+    else if (i % 61 == 13)
+      row.rarity = exotic ? PET_RARITY_NORMAL : PET_RARITY_EXOTIC;
+
+    if (i % 100 == 0)
+      (exotic ? _rareExotic : _rare).insert(row.entry);
+  }
+}
+
+std::vector<BeastmasterTameRow> FakeWorldDatabase::QueryTames() const {
+  std::this_thread::sleep_for(_latency + _perRow * _tames.size());
+  return _tames;
+}
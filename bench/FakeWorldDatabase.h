@@ -0,0 +1,56 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_FAKE_WORLD_DATABASE_H_
+#define _BEASTMASTER_FAKE_WORLD_DATABASE_H_
+
+#include "BeastmasterTameRows.h"
+#include <chrono>
+#include <set>
+#include <vector>
+
+/**
+ * FakeWorldDatabase
+ * In-process stand-in for the world database behind the catalog load: the
+ * beastmaster_tames rows joined with creature_template, as BM_WORLD_SEL_TAMES
+ * returns them. Like a hand-edited table, some rows have no template, some
+ * are not tameable and some have the wrong rarity. A query waits for the
+ * round trip latency plus a transfer time per row.
+ */
+class FakeWorldDatabase {
+public:
+  FakeWorldDatabase(std::size_t tames, std::chrono::microseconds latency,
+                    std::chrono::nanoseconds perRow);
+
+  std::vector<BeastmasterTameRow> QueryTames() const;
+
+  // The BeastMaster.RarePets and BeastMaster.RareExoticPets lists.
+  std::set<uint32> const &GetRarePetEntries() const { return _rare; }
+  std::set<uint32> const &GetRareExoticPetEntries() const {
+    return _rareExotic;
+  }
+
+private:
+  std::vector<BeastmasterTameRow> _tames;
+  std::set<uint32> _rare;
+  std::set<uint32> _rareExotic;
+  std::chrono::microseconds _latency;
+  std::chrono::nanoseconds _perRow;
+};
+
+#endif // _BEASTMASTER_FAKE_WORLD_DATABASE_H_
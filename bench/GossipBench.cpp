@@ -0,0 +1,254 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterGossipMenu.h"
+#include "BenchData.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <set>
+
+namespace {
+// What a page costs to hand to the core: the items as the player's menu
+// stores them.
+struct MenuItem {
+  uint32 icon;
+  uint32 action;
+  std::string text;
+};
+
+constexpr std::size_t SHIPPED_PETS = 1060;
+
+void BM_CatalogPagesBuild(benchmark::State &state) {
+  auto catalog = BenchData::MakeCatalog(SHIPPED_PETS);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(BuildCatalogPages(*catalog, {7, 4}));
+}
+BENCHMARK(BM_CatalogPagesBuild)->Unit(benchmark::kMicrosecond);
+
+// Random category pages for a player with every tenth pet tamed.
+template <typename Serve>
+void ServePages(benchmark::State &state, BeastmasterCatalog const &catalog,
+                Serve &&serve) {
+  std::vector<bool> tamedRows(catalog.GetSize());
+  for (std::size_t row = 0; row < tamedRows.size(); row += 10)
+    tamedRows[row] = true;
+
+  std::mt19937 rng(42);
+  std::vector<std::pair<BeastmasterPetCategory, uint32>> requests;
+  for (uint32 i = 0; i < 1024; ++i) {
+    auto category = BeastmasterPetCategory(rng() % MAX_PET_CATEGORIES);
+    uint32 pages =
+        GetPageCount(catalog.GetCategory(category).size(), PET_PAGE_SIZE);
+    requests.emplace_back(category, 1 + rng() % pages);
+  }
+
+  std::vector<MenuItem> menu;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto [category, page] = requests[i++ % requests.size()];
+    menu.clear();
+    serve(category, page, tamedRows, menu);
+    benchmark::DoNotOptimize(menu.data());
+  }
+}
+
+// Copies prebuilt items, picking the tamed text from the row bitset.
+void BM_CatalogPageServe(benchmark::State &state) {
+  auto catalog = BenchData::MakeCatalog(SHIPPED_PETS);
+  catalog->SetGossipPages(BuildCatalogPages(*catalog, {7, 4}));
+  ServePages(state, *catalog,
+             [&](BeastmasterPetCategory category, uint32 page,
+                 std::vector<bool> const &tamedRows,
+                 std::vector<MenuItem> &menu) {
+               for (auto const &item :
+                    catalog->GetGossipPages().GetPage(category, page)) {
+                 bool tamed = item.row != BeastmasterGossipItem::NO_ROW &&
+                              tamedRows[item.row];
+                 menu.push_back({item.icon, item.action,
+                                 tamed ? item.tamedText : item.text});
+               }
+             });
+}
+BENCHMARK(BM_CatalogPageServe);
+
+// The per-click rendering the prebuilt pages replaced: navigation and
+// names formatted for every request, tamed pets looked up by entry.
+void BM_LegacyCatalogPageServe(benchmark::State &state) {
+  auto catalog = BenchData::MakeCatalog(SHIPPED_PETS);
+  std::set<uint32> tamedEntries;
+  for (std::size_t row = 0; row < catalog->GetSize(); row += 10)
+    tamedEntries.insert(catalog->GetPet(uint32(row)).entry);
+
+  ServePages(state, *catalog,
+             [&](BeastmasterPetCategory category, uint32 page,
+                 std::vector<bool> const &, std::vector<MenuItem> &menu) {
+               auto rows = catalog->GetCategory(category);
+               uint32 pageCount = GetPageCount(rows.size(), PET_PAGE_SIZE);
+               menu.push_back(
+                   {7, EncodeGossipAction(GOSSIP_OPCODE_MAIN_MENU), "Back.."});
+               if (page > 1)
+                 menu.push_back({4, EncodeCatalogPageAction(category, page - 1),
+                                 "Previous.."});
+               if (page < pageCount)
+                 menu.push_back({4, EncodeCatalogPageAction(category, page + 1),
+                                 "Next.."});
+               for (std::size_t i = (page - 1) * PET_PAGE_SIZE;
+                    i < rows.size() && i < page * PET_PAGE_SIZE; ++i) {
+                 PetInfo pet = catalog->GetPet(rows[i]);
+                 std::string name(pet.name);
+                 if (tamedEntries.count(pet.entry))
+                   name += " (Already Tamed)";
+                 menu.push_back(
+                     {pet.icon, EncodeAdoptAction(pet.entry), std::move(name)});
+               }
+             });
+}
+BENCHMARK(BM_LegacyCatalogPageServe);
+
+// Clicks spread over every opcode, with the payloads the menus send.
+std::vector<uint32> MakeGossipActions(std::mt19937 &rng) {
+  std::vector<uint32> actions;
+  for (uint32 i = 0; i < 4096; ++i) {
+    auto opcode = BeastmasterGossipOpcode(rng() % MAX_GOSSIP_OPCODES);
+    uint32 payload = 0;
+    switch (opcode) {
+    case GOSSIP_OPCODE_CATALOG_PAGE:
+      payload = GetGossipPayload(EncodeCatalogPageAction(
+          BeastmasterPetCategory(rng() % MAX_PET_CATEGORIES), 1 + rng() % 30));
+      break;
+    case GOSSIP_OPCODE_ADOPT:
+      payload = 1 + rng() % 40000;
+      break;
+    case GOSSIP_OPCODE_TRACKED_MENU:
+      payload = rng() % 3;
+      break;
+    case GOSSIP_OPCODE_TRACKED_SUMMON:
+    case GOSSIP_OPCODE_TRACKED_RENAME:
+    case GOSSIP_OPCODE_TRACKED_DELETE:
+      payload = rng() % PET_TRACKED_PAGE_SIZE;
+      break;
+    default:
+      break;
+    }
+    actions.push_back(EncodeGossipAction(opcode, payload));
+  }
+  return actions;
+}
+
+using BenchGossipHandler = uint32 (*)(uint32 payload);
+
+uint32 BenchCatalogPage(uint32 payload) {
+  BeastmasterPetCategory category;
+  uint32 page;
+  return DecodeCatalogPagePayload(payload, category, page) ? page : 0;
+}
+
+uint32 BenchPayload(uint32 payload) { return payload; }
+uint32 BenchNoPayload(uint32) { return 1; }
+
+constexpr BenchGossipHandler BenchGossipRoutes[MAX_GOSSIP_OPCODES] = {
+    BenchNoPayload, BenchNoPayload, BenchCatalogPage, BenchPayload,
+    BenchNoPayload, BenchNoPayload, BenchNoPayload,   BenchPayload,
+    BenchPayload,   BenchPayload,   BenchPayload};
+
+// One table lookup per click, as GossipSelect dispatches now.
+void BM_GossipDispatch(benchmark::State &state) {
+  std::mt19937 rng(42);
+  auto actions = MakeGossipActions(rng);
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    uint32 action = actions[i++ % actions.size()];
+    benchmark::DoNotOptimize(
+        BenchGossipRoutes[GetGossipOpcode(action)](GetGossipPayload(action)));
+  }
+}
+BENCHMARK(BM_GossipDispatch);
+
+// The range checks GossipSelect made before the opcode table, on the action
+// numbering of the time. The same clicks, renumbered.
+uint32 LegacyGossipDispatch(uint32 action) {
+  constexpr uint32 pageStarts[] = {501, 601, 701, 801};
+  if (action == 50)
+    return 1;
+  if (action >= 501 && action < 901) {
+    uint32 index = 0;
+    while (index + 1 < 4 && action >= pageStarts[index + 1])
+      ++index;
+    return action - pageStarts[index] + 1;
+  }
+  if (action == 80 || action == 14 || action == 3)
+    return 1;
+  if (action >= 1000 && action < 2000)
+    return action - 1000 + 1;
+  if (action >= 2000 && action < 3000)
+    return action - 2000;
+  if (action >= 3000 && action < 4000)
+    return action - 3000;
+  if (action >= 4000 && action < 5000)
+    return action - 4000;
+  if (action >= 901)
+    return action - 901;
+  return 0;
+}
+
+uint32 ToLegacyGossipAction(uint32 action) {
+  uint32 payload = GetGossipPayload(action);
+  switch (GetGossipOpcode(action)) {
+  case GOSSIP_OPCODE_MAIN_MENU:
+    return 50;
+  case GOSSIP_OPCODE_CATALOG_PAGE: {
+    BeastmasterPetCategory category{};
+    uint32 page = 0;
+    DecodeCatalogPagePayload(payload, category, page);
+    return 501 + 100 * uint32(category) + page - 1;
+  }
+  case GOSSIP_OPCODE_ADOPT:
+    return 901 + payload;
+  case GOSSIP_OPCODE_REMOVE_SKILLS:
+    return 80;
+  case GOSSIP_OPCODE_STABLE:
+    return 14;
+  case GOSSIP_OPCODE_VENDOR:
+    return 3;
+  case GOSSIP_OPCODE_TRACKED_MENU:
+    return 1000 + payload;
+  case GOSSIP_OPCODE_TRACKED_SUMMON:
+    return 2000 + payload;
+  case GOSSIP_OPCODE_TRACKED_RENAME:
+    return 3000 + payload;
+  case GOSSIP_OPCODE_TRACKED_DELETE:
+    return 4000 + payload;
+  default:
+    return 0;
+  }
+}
+
+void BM_LegacyGossipDispatch(benchmark::State &state) {
+  std::mt19937 rng(42);
+  auto actions = MakeGossipActions(rng);
+  for (uint32 &action : actions)
+    action = ToLegacyGossipAction(action);
+
+  std::size_t i = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        LegacyGossipDispatch(actions[i++ % actions.size()]));
+}
+BENCHMARK(BM_LegacyGossipDispatch);
+} // namespace
@@ -0,0 +1,107 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterNameValidator.h"
+#include "BeastmasterProfanityFilter.h"
+#include "BenchData.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cctype>
+#include <regex>
+#include <unordered_set>
+
+namespace {
+void BM_NameValidator(benchmark::State &state) {
+  std::vector<std::string> names = BenchData::MakeNameCandidates(4096);
+  std::size_t i = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        BeastmasterNameValidator::IsValid(names[i++ % names.size()]));
+}
+BENCHMARK(BM_NameValidator);
+
+// The regex check the validator replaced.
+void BM_LegacyNameRegex(benchmark::State &state) {
+  static std::regex const allowed("^[A-Za-z][A-Za-z \\-']*[A-Za-z]$");
+  std::vector<std::string> names = BenchData::MakeNameCandidates(4096);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    std::string const &name = names[i++ % names.size()];
+    bool valid = name.size() >= 2 && name.size() <= 16 &&
+                 !std::isspace(uint8(name.front())) &&
+                 !std::isspace(uint8(name.back())) &&
+                 std::regex_match(name, allowed);
+    benchmark::DoNotOptimize(valid);
+  }
+}
+BENCHMARK(BM_LegacyNameRegex);
+
+void WordCounts(benchmark::internal::Benchmark *b) {
+  b->Arg(10000)->Arg(100000);
+}
+
+void BM_ProfanityFilterBuild(benchmark::State &state) {
+  std::vector<std::string> words =
+      BenchData::MakeWords(std::size_t(state.range(0)));
+  std::size_t states = 0;
+  std::size_t bytes = 0;
+  for (auto _ : state) {
+    BeastmasterProfanityFilter filter(words, true);
+    states = filter.GetStateCount();
+    bytes = filter.GetMemoryUsage();
+  }
+  state.counters["states"] = double(states);
+  state.counters["bytes"] = double(bytes);
+}
+BENCHMARK(BM_ProfanityFilterBuild)
+    ->Apply(WordCounts)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_ProfanityFilterMatch(benchmark::State &state) {
+  BeastmasterProfanityFilter filter(
+      BenchData::MakeWords(std::size_t(state.range(0))), true);
+  std::vector<std::string> names = BenchData::MakeNameCandidates(2000, 7);
+  std::size_t i = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(filter.Matches(names[i++ % names.size()]));
+}
+BENCHMARK(BM_ProfanityFilterMatch)->Apply(WordCounts);
+
+// The scan the automaton replaced: every word searched for in turn.
+void BM_LegacyProfanityScan(benchmark::State &state) {
+  std::vector<std::string> list =
+      BenchData::MakeWords(std::size_t(state.range(0)));
+  std::unordered_set<std::string> words(list.begin(), list.end());
+  std::vector<std::string> names = BenchData::MakeNameCandidates(2000, 7);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    std::string lower = names[i++ % names.size()];
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    bool profane = false;
+    for (auto const &word : words)
+      if (lower.find(word) != std::string::npos) {
+        profane = true;
+        break;
+      }
+    benchmark::DoNotOptimize(profane);
+  }
+}
+BENCHMARK(BM_LegacyProfanityScan)
+    ->Apply(WordCounts)
+    ->Unit(benchmark::kMicrosecond);
+} // namespace
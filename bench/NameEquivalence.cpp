@@ -0,0 +1,135 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Checks that BeastmasterNameValidator, with the default policy, accepts
+ * exactly the names the regex check it replaced did: every string of up to
+ * 5 characters over a mixed alphabet, then seeded random strings. Prints
+ * each mismatch and exits with status 1 if there is any.
+ *
+ *   bench/build/beastmaster_name_check [--random=<count>] [--seed=<n>]
+ */
+
+#include "BeastmasterNameValidator.h"
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <regex>
+#include <string>
+
+namespace {
+// Letters at both ends of the range, the separators, whitespace the old
+// guards looked for, digits and the two bytes of U+00E9.
+constexpr char const *ALPHABET[] = {"a",  "Z", " ", "-",    "'",   "\t",
+                                    "\n", "0", "9", "\xC3", "\xA9"};
+constexpr std::size_t EXHAUSTIVE_LENGTH = 5;
+
+bool IsValidLegacy(std::string const &name) {
+  static std::regex const allowed("^[A-Za-z][A-Za-z \\-']*[A-Za-z]$");
+  return name.size() >= 2 && name.size() <= 16 &&
+         !std::isspace(uint8(name.front())) &&
+         !std::isspace(uint8(name.back())) &&
+         std::regex_match(name, allowed);
+}
+
+struct Checker {
+  uint64 inputs = 0;
+  uint64 mismatches = 0;
+
+  void Check(std::string const &name) {
+    ++inputs;
+    bool expected = IsValidLegacy(name);
+    if (BeastmasterNameValidator::IsValid(name) == expected)
+      return;
+
+    if (++mismatches <= 20) {
+      std::printf("mismatch: regex %s, validator %s:",
+                  expected ? "accepts" : "rejects",
+                  expected ? "rejects" : "accepts");
+      for (char ch : name)
+        std::printf(" %02X", uint8(ch));
+      std::printf("\n");
+    }
+  }
+
+  // Every string of exactly the given number of alphabet characters.
+  void CheckAll(std::string &name, std::size_t length) {
+    if (!length) {
+      Check(name);
+      return;
+    }
+    for (char const *ch : ALPHABET) {
+      std::size_t size = name.size();
+      name += ch;
+      CheckAll(name, length - 1);
+      name.resize(size);
+    }
+  }
+};
+
+// Mostly letters so that a fair share passes, with any byte mixed in.
+std::string MakeRandomName(std::mt19937 &rng) {
+  static char const common[] = "abcxyzABCXYZ -'";
+  std::uniform_int_distribution<uint32> length(0, 20);
+  std::uniform_int_distribution<uint32> kind(0, 9);
+  std::uniform_int_distribution<uint32> pick(0, sizeof(common) - 2);
+  std::uniform_int_distribution<uint32> byte(0, 255);
+
+  std::string name(length(rng), '\0');
+  for (char &ch : name)
+    ch = kind(rng) ? common[pick(rng)] : char(byte(rng));
+  return name;
+}
+
+bool ParseUInt(char const *arg, char const *option, uint32 &value) {
+  std::size_t length = std::strlen(option);
+  if (std::strncmp(arg, option, length))
+    return false;
+  char const *last = arg + std::strlen(arg);
+  auto [ptr, ec] = std::from_chars(arg + length, last, value);
+  return ec == std::errc() && ptr == last;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  uint32 randomCount = 2000000;
+  uint32 seed = 42;
+  for (int i = 1; i < argc; ++i)
+    if (!ParseUInt(argv[i], "--random=", randomCount) &&
+        !ParseUInt(argv[i], "--seed=", seed)) {
+      std::fprintf(stderr,
+                   "usage: %s [--random=<count>] [--seed=<n>]\n", argv[0]);
+      return 2;
+    }
+
+  Checker checker;
+  std::string name;
+  for (std::size_t length = 0; length <= EXHAUSTIVE_LENGTH; ++length)
+    checker.CheckAll(name, length);
+
+  std::mt19937 rng(seed);
+  for (uint32 i = 0; i < randomCount; ++i)
+    checker.Check(MakeRandomName(rng));
+
+  std::printf("%llu inputs, %llu mismatches\n",
+              (unsigned long long)checker.inputs,
+              (unsigned long long)checker.mismatches);
+  return checker.mismatches ? 1 : 0;
+}
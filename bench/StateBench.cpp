@@ -0,0 +1,224 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterCooldowns.h"
+#include "BeastmasterMetrics.h"
+#include "BeastmasterTrackedPages.h"
+#include "BeastmasterTrackedPetsCache.h"
+#include "BenchData.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include <random>
+#include <tuple>
+#include <unordered_map>
+
+namespace {
+constexpr uint64 PLAYERS = 5000;
+
+// Every call a summon attempt by a random player, one in-game second per
+// thousand attempts, so cooldowns keep starting and expiring.
+void BM_CooldownTryStart(benchmark::State &state) {
+  static BeastmasterCooldowns cooldowns;
+  std::mt19937_64 rng(state.thread_index());
+  uint64 attempts = 0;
+  for (auto _ : state) {
+    time_t now = time_t(1000000 + attempts++ / 1000);
+    benchmark::DoNotOptimize(cooldowns.TryStart(BEASTMASTER_COOLDOWN_SUMMON,
+                                                rng() % PLAYERS, 120, now));
+  }
+  if (state.thread_index() == 0)
+    state.counters["tracked"] =
+        double(cooldowns.GetSize(BEASTMASTER_COOLDOWN_SUMMON));
+}
+BENCHMARK(BM_CooldownTryStart)->ThreadRange(1, 8)->UseRealTime();
+
+// The map the cooldowns replaced, given the lock it lacked; it never
+// forgets a player.
+void BM_LegacyCooldown(benchmark::State &state) {
+  static std::unordered_map<uint64, time_t> lastSummonTime;
+  static std::mutex lock;
+  std::mt19937_64 rng(state.thread_index());
+  uint64 attempts = 0;
+  for (auto _ : state) {
+    time_t now = time_t(1000000 + attempts++ / 1000);
+    uint64 guid = rng() % PLAYERS;
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = lastSummonTime.find(guid);
+    bool allowed = it == lastSummonTime.end() || now - it->second >= 120;
+    if (allowed)
+      lastSummonTime[guid] = now;
+    benchmark::DoNotOptimize(allowed);
+  }
+}
+BENCHMARK(BM_LegacyCooldown)->ThreadRange(1, 8)->UseRealTime();
+
+TrackedPetList MakeTrackedPets(uint64 guid) {
+  static std::vector<std::string> const names = BenchData::MakeNames(64);
+  TrackedPetList pets;
+  for (uint32 i = 0; i < 20; ++i)
+    pets.emplace_back(uint32(guid * 20 + i), names[(guid + i) % names.size()],
+                      time_t(1700000000 + i));
+  return pets;
+}
+
+// Menu opens by random players: a copy out on a hit, a fill on a miss.
+void BM_TrackedPetsCache(benchmark::State &state) {
+  static BeastmasterTrackedPetsCache cache;
+  if (state.thread_index() == 0)
+    cache.SetBudget(4096 * 1024);
+
+  std::mt19937_64 rng(state.thread_index());
+  TrackedPetList pets;
+  for (auto _ : state) {
+    uint64 guid = rng() % PLAYERS;
+    if (!cache.Get(guid, pets))
+      cache.Put(guid, MakeTrackedPets(guid));
+    benchmark::DoNotOptimize(pets.data());
+  }
+  if (state.thread_index() == 0) {
+    auto stats = cache.GetStats();
+    uint64 lookups = std::max<uint64>(1, stats.hits + stats.misses);
+    state.counters["hit_rate"] = double(stats.hits) / double(lookups);
+  }
+}
+BENCHMARK(BM_TrackedPetsCache)->ThreadRange(1, 8)->UseRealTime();
+
+// The cache it replaced: one map behind one mutex, rows as string tuples.
+void BM_LegacyTrackedPetsCache(benchmark::State &state) {
+  using LegacyList = std::vector<std::tuple<uint32, std::string, std::string>>;
+  static std::unordered_map<uint64, LegacyList> cache;
+  static std::mutex lock;
+
+  std::mt19937_64 rng(state.thread_index());
+  LegacyList pets;
+  for (auto _ : state) {
+    uint64 guid = rng() % PLAYERS;
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = cache.find(guid);
+    if (it != cache.end()) {
+      pets = it->second;
+    } else {
+      LegacyList list;
+      for (auto const &pet : MakeTrackedPets(guid))
+        list.emplace_back(pet.entry, std::string(pet.GetName()),
+                          "2024-01-01 00:00:00");
+      cache.emplace(guid, std::move(list));
+    }
+    benchmark::DoNotOptimize(pets.data());
+  }
+}
+BENCHMARK(BM_LegacyTrackedPetsCache)->ThreadRange(1, 8)->UseRealTime();
+
+// One owner's rows in the (owner_guid, date_tamed, entry) index: oldest
+// first, a few pets tamed in the same second.
+TrackedPetList MakeOwnerIndex(std::size_t count) {
+  static std::vector<std::string> const names = BenchData::MakeNames(64);
+  TrackedPetList rows;
+  for (std::size_t i = 0; i < count; ++i)
+    rows.emplace_back(uint32(1000 + i), names[i % names.size()],
+                      time_t(1700000000 + i / 3));
+  std::sort(rows.begin(), rows.end(), [](auto const &a, auto const &b) {
+    return BeastmasterTrackedKey::Of(b).IsBefore(BeastmasterTrackedKey::Of(a));
+  });
+  return rows;
+}
+
+// Paging through one owner's collection, Next after Next: a seek into the
+// index, TRACKED_PAGE_QUERY_LIMIT rows read backwards from it, the page
+// built from them.
+void BM_TrackedPage(benchmark::State &state) {
+  TrackedPetList const index = MakeOwnerIndex(state.range(0));
+  BeastmasterTrackedPageQuery query;
+  TrackedPetList rows;
+  TrackedPetList pets;
+  uint64 rowsRead = 0;
+  for (auto _ : state) {
+    auto end = index.end();
+    if (query.seek == TRACKED_SEEK_AFTER)
+      end = std::lower_bound(index.begin(), index.end(), query.key,
+                             [](auto const &row, auto const &key) {
+                               return key.IsBefore(
+                                   BeastmasterTrackedKey::Of(row));
+                             });
+    rows.clear();
+    for (auto it = end; it != index.begin() &&
+                        rows.size() < TRACKED_PAGE_QUERY_LIMIT;)
+      rows.push_back(*--it);
+    rowsRead += rows.size();
+
+    BeastmasterTrackedPageBuilder builder(query, std::move(rows));
+    auto page = builder.Build(pets);
+    query = page.hasNext ? page.GetNext() : BeastmasterTrackedPageQuery{};
+    benchmark::DoNotOptimize(pets.data());
+  }
+  state.counters["rows_read"] = benchmark::Counter(
+      double(rowsRead), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_TrackedPage)->Arg(10)->Arg(1000)->Arg(10000);
+
+// The full list query it replaced: every row of the owner read, sorted by
+// date_tamed and sliced to the page.
+void BM_LegacyTrackedPage(benchmark::State &state) {
+  TrackedPetList const index = MakeOwnerIndex(state.range(0));
+  uint32 pageCount = GetPageCount(index.size(), PET_TRACKED_PAGE_SIZE);
+  uint32 page = 1;
+  TrackedPetList rows;
+  TrackedPetList pets;
+  uint64 rowsRead = 0;
+  for (auto _ : state) {
+    rows.assign(index.begin(), index.end());
+    std::stable_sort(rows.begin(), rows.end(),
+                     [](auto const &a, auto const &b) {
+                       return a.tamedAt > b.tamedAt;
+                     });
+    rowsRead += rows.size();
+
+    BeastmasterPageSlice slice =
+        GetPageSlice(rows.size(), page, PET_TRACKED_PAGE_SIZE);
+    pets.assign(rows.begin() + slice.first,
+                rows.begin() + slice.first + slice.count);
+    page = page % pageCount + 1;
+    benchmark::DoNotOptimize(pets.data());
+  }
+  state.counters["rows_read"] = benchmark::Counter(
+      double(rowsRead), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_LegacyTrackedPage)->Arg(10)->Arg(1000)->Arg(10000);
+
+// An empty timed scope, with instrumentation off (0) and on (1): the
+// overhead each timed handler pays.
+void BM_MetricsTimer(benchmark::State &state) {
+  BeastmasterMetrics::SetEnabled(state.range(0));
+  for (auto _ : state) {
+    BeastmasterTimer timer(METRIC_SHOW_MAIN_MENU);
+    benchmark::ClobberMemory();
+  }
+  BeastmasterMetrics::SetEnabled(true);
+}
+BENCHMARK(BM_MetricsTimer)->Arg(0)->Arg(1)->ThreadRange(1, 8)->UseRealTime();
+
+void BM_MetricsCollect(benchmark::State &state) {
+  for (uint32 i = 0; i < 1000; ++i)
+    BeastmasterMetrics::Record(METRIC_SHOW_MAIN_MENU, i * 1000);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        BeastmasterMetrics::Collect(METRIC_SHOW_MAIN_MENU));
+}
+BENCHMARK(BM_MetricsCollect);
+} // namespace
@@ -0,0 +1,683 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Headless load generator for the beastmaster gossip flow.
+ *
+ * N simulated players are split over M threads, each thread standing in
+ * for a map thread that owns its players. Every step a player performs one
+ * of the module's handlers and its latency is recorded. The handlers need a
+ * live worldserver, so each one is replayed here as the module work it
+ * does: the same snapshots, catalog pages, validators, cooldowns, cache and
+ * journal queue, with FakeDatabase in place of CharacterDatabase and
+ * FakeWorldDatabase in place of WorldDatabase. Query results come back as
+ * callbacks that the owning thread runs on the player's next step, like
+ * the session's query processor, and get the journal's pending writes
+ * applied. A flusher thread stands in for the world update: it hands the
+ * journal to the database every --flush-ms, or early once it fills up.
+ * Players wait a random think time of up to twice --think-ms between
+ * steps; --think-ms=0 drives them flat out.
+ *
+ * The catalog is loaded from the world database fake at startup, and again
+ * every --catalog-reload-ms while the players run if that is set.
+ *
+ *   beastmaster_stress --players=5000 --threads=4 --seconds=10 \
+ *                      --think-ms=1000 --db-connections=2 --db-latency-us=500
+ */
+
+#include "BeastmasterCatalog.h"
+#include "BeastmasterCooldowns.h"
+#include "BeastmasterGossipMenu.h"
+#include "BeastmasterJournalQueue.h"
+#include "BeastmasterMutex.h"
+#include "BeastmasterNameValidator.h"
+#include "BeastmasterProfanityFilter.h"
+#include "BeastmasterSnapshot.h"
+#include "BeastmasterTameRows.h"
+#include "BeastmasterTrackedPages.h"
+#include "BeastmasterTrackedPetsCache.h"
+#include "BenchData.h"
+#include "FakeDatabase.h"
+#include "FakeWorldDatabase.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string_view>
+#include <thread>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  uint32 players = 5000;
+  uint32 threads = 4;
+  uint32 seconds = 10;
+  uint32 thinkMs = 1000;
+  uint32 pets = 1060;
+  uint32 dbConnections = 2;
+  uint32 dbLatencyUs = 500;
+  uint32 dbJitterUs = 250;
+  uint32 flushMs = 1000;
+  uint32 catalogReloadMs = 0;
+};
+
+enum Action {
+  ACTION_MAIN_MENU = 0,
+  ACTION_BROWSE,
+  ACTION_ADOPT,
+  ACTION_TRACKED_MENU_HIT,
+  ACTION_TRACKED_MENU_MISS, // Request to rendered page, query included
+  ACTION_RENAME,
+  ACTION_SUMMON,
+  MAX_ACTIONS
+};
+
+// Handler mix of one step; the tracked menu splits into hit and miss.
+struct ActionWeight {
+  Action action;
+  char const *name;
+  uint32 weight;
+};
+
+constexpr ActionWeight ActionTable[MAX_ACTIONS] = {
+    {ACTION_MAIN_MENU, "ShowMainMenu", 25},
+    {ACTION_BROWSE, "GossipSelect (browse)", 35},
+    {ACTION_ADOPT, "CreatePet", 10},
+    {ACTION_TRACKED_MENU_HIT, "ShowTrackedPetsMenu (hit)", 15},
+    {ACTION_TRACKED_MENU_MISS, "ShowTrackedPetsMenu (miss)", 0},
+    {ACTION_RENAME, ".petname rename", 10},
+    {ACTION_SUMMON, ".beastmaster", 5},
+};
+
+constexpr uint32 MAX_TRACKED_PETS = 20;
+constexpr uint32 SUMMON_COOLDOWN = 120;
+constexpr std::size_t MAX_SAMPLES = 1 << 22; // Per action and thread
+// World database transfer time per beastmaster_tames row.
+constexpr std::chrono::nanoseconds WORLD_ROW_TIME{500};
+
+// What the core's PlayerMenu keeps per item.
+struct MenuItem {
+  uint32 icon;
+  uint32 action;
+  std::string text;
+};
+
+struct SimPlayer {
+  uint64 guid = 0;
+  Clock::time_point nextStep;
+  std::vector<bool> tamedRows;
+  std::vector<uint32> tamedEntries;
+  bool queryInFlight = false;
+  Clock::time_point queryStart;
+
+  BeastmasterLockStats callbackLockStats;
+  BeastmasterMutex callbackLock{callbackLockStats};
+  std::vector<std::function<void()>> callbacks;
+};
+
+struct ThreadResult {
+  std::array<std::vector<uint32>, MAX_ACTIONS> samples; // ns
+  std::array<uint64, MAX_ACTIONS> counts = {};
+};
+
+class Simulation {
+public:
+  Simulation(Options const &options, FakeDatabase &db,
+             FakeWorldDatabase const &world)
+      : _options(options), _db(db), _world(world) {
+    LoadCatalog();
+    _profanity.Publish(std::make_shared<BeastmasterProfanityFilter>(
+        BenchData::MakeWords(2000, 99), true));
+    _cache.SetBudget(4096 * 1024);
+    _names = BenchData::MakeNameCandidates(1024, 3);
+
+    uint32 pets = _catalog.Get()->GetSize();
+    for (uint32 i = 0; i < options.players; ++i) {
+      auto player = std::make_unique<SimPlayer>();
+      player->guid = i + 1;
+      player->tamedRows.resize(pets);
+      _players.push_back(std::move(player));
+    }
+  }
+
+  // As LoadSystem() does without a catalog file: query the tames, validate
+  // them and publish the new catalog with its gossip pages.
+  void LoadCatalog() {
+    Clock::time_point start = Clock::now();
+    std::vector<BeastmasterTameRow> rows = _world.QueryTames();
+    Clock::time_point queried = Clock::now();
+
+    BeastmasterTameRules rules{3, 1, _world.GetRarePetEntries(),
+                               _world.GetRareExoticPetEntries()};
+    std::size_t chunks = 0;
+    _catalogStats = ValidateTameRows(rows, rules, chunks);
+    Clock::time_point validated = Clock::now();
+
+    auto catalog = BuildCatalog(rows, 1);
+    catalog->SetGossipPages(BuildCatalogPages(*catalog, {7, 4}));
+    uint32 pets = catalog->GetSize();
+    _catalog.Publish(std::move(catalog));
+
+    auto ms = [](Clock::duration elapsed) {
+      return std::chrono::duration<double, std::milli>(elapsed).count();
+    };
+    ++_catalogLoads;
+    _catalogLoadMs += ms(Clock::now() - start);
+    if (_catalogLoads == 1)
+      std::printf("catalog: %u pets from %zu tames in %.2f ms (query %.2f "
+                  "ms, validate %.2f ms in %zu chunks, build %.2f ms); "
+                  "skipped %u without a template and %u not tameable, "
+                  "corrected %u rarities\n\n",
+                  pets, rows.size(), ms(Clock::now() - start),
+                  ms(queried - start), ms(validated - queried), chunks,
+                  ms(Clock::now() - validated),
+                  _catalogStats.missingTemplate, _catalogStats.notTameable,
+                  _catalogStats.rarityCorrected);
+  }
+
+  // Stands in for the world update: flushes the journal every --flush-ms,
+  // early when it fills up, and reloads the catalog every
+  // --catalog-reload-ms.
+  void RunWorld(Clock::time_point deadline) {
+    auto reloadInterval = std::chrono::milliseconds(_options.catalogReloadMs);
+    Clock::time_point nextFlush = Clock::now();
+    Clock::time_point nextReload = Clock::now() + reloadInterval;
+    while (Clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      Clock::time_point now = Clock::now();
+      if (now >= nextFlush ||
+          _journal.GetPendingCount() >= BeastmasterJournalQueue::MAX_PENDING) {
+        nextFlush = now + std::chrono::milliseconds(_options.flushMs);
+        _journal.Flush(
+            [this](BeastmasterJournalQueue::Batch const &batch) {
+              WriteBatch(batch);
+            });
+      }
+      if (_options.catalogReloadMs && now >= nextReload) {
+        nextReload = now + reloadInterval;
+        LoadCatalog();
+      }
+    }
+  }
+
+  void Run(uint32 thread, Clock::time_point deadline, ThreadResult &result) {
+    std::mt19937 rng(thread + 1);
+    uint32 first = uint32(uint64(_players.size()) * thread / _options.threads);
+    uint32 last =
+        uint32(uint64(_players.size()) * (thread + 1) / _options.threads);
+    uint32 totalWeight = 0;
+    for (ActionWeight const &entry : ActionTable)
+      totalWeight += entry.weight;
+
+    std::vector<MenuItem> menu;
+    Clock::time_point start = Clock::now();
+    for (uint32 i = first; i < last; ++i)
+      _players[i]->nextStep = start + Think(rng);
+
+    for (uint32 i = first; Clock::now() < deadline;
+         i = i + 1 < last ? i + 1 : first) {
+      SimPlayer &player = *_players[i];
+      RunCallbacks(player, menu, result);
+      if (i == first && _options.thinkMs) // Once per sweep, as a map update
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      if (Clock::now() < player.nextStep)
+        continue;
+      player.nextStep = Clock::now() + Think(rng);
+
+      uint32 pick = rng() % totalWeight;
+      Action action = ActionTable[0].action;
+      for (ActionWeight const &entry : ActionTable) {
+        if (pick < entry.weight) {
+          action = entry.action;
+          break;
+        }
+        pick -= entry.weight;
+      }
+
+      menu.clear();
+      Clock::time_point begin = Clock::now();
+      switch (action) {
+      case ACTION_MAIN_MENU:
+        ShowMainMenu(menu);
+        break;
+      case ACTION_BROWSE:
+        Browse(player, rng, menu);
+        break;
+      case ACTION_ADOPT:
+        Adopt(player, rng);
+        break;
+      case ACTION_TRACKED_MENU_HIT:
+        // A miss is recorded when its query result has been rendered.
+        if (!ShowTrackedPetsMenu(player, menu))
+          continue;
+        break;
+      case ACTION_RENAME:
+        Rename(player, rng);
+        break;
+      case ACTION_SUMMON: {
+        auto now = time_t(std::chrono::duration_cast<std::chrono::seconds>(
+                              Clock::now() - start)
+                              .count());
+        _cooldowns.TryStart(BEASTMASTER_COOLDOWN_SUMMON, player.guid,
+                            SUMMON_COOLDOWN, now);
+        break;
+      }
+      default:
+        break;
+      }
+      Record(result, action, Clock::now() - begin);
+    }
+  }
+
+  BeastmasterTrackedPetsCache::Stats GetCacheStats() const {
+    return _cache.GetStats();
+  }
+
+  uint64 GetJournalBatches() const { return _journalBatches; }
+  uint64 GetJournalWrites() const { return _journalWrites; }
+  std::size_t GetJournalPending() const { return _journal.GetPendingCount(); }
+  uint32 GetCatalogLoads() const { return _catalogLoads; }
+  double GetAverageCatalogLoadMs() const {
+    return _catalogLoads ? _catalogLoadMs / _catalogLoads : 0.0;
+  }
+
+  // Summed over every player's callback queue.
+  void GetCallbackLockStats(uint64 &contentions,
+                            uint64 &waitNanoseconds) const {
+    contentions = waitNanoseconds = 0;
+    for (auto const &player : _players) {
+      contentions += player->callbackLockStats.contentions;
+      waitNanoseconds += player->callbackLockStats.waitNanoseconds;
+    }
+  }
+
+private:
+  Clock::duration Think(std::mt19937 &rng) const {
+    if (!_options.thinkMs)
+      return Clock::duration::zero();
+    return std::chrono::microseconds(rng() % (_options.thinkMs * 2000 + 1));
+  }
+
+  static void Record(ThreadResult &result, Action action,
+                     Clock::duration elapsed) {
+    ++result.counts[action];
+    if (result.samples[action].size() < MAX_SAMPLES)
+      result.samples[action].push_back(uint32(std::min<int64>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+              .count(),
+          ~uint32(0))));
+  }
+
+  void RunCallbacks(SimPlayer &player, std::vector<MenuItem> &menu,
+                    ThreadResult &result) {
+    std::vector<std::function<void()>> callbacks;
+    {
+      std::lock_guard<BeastmasterMutex> lock(player.callbackLock);
+      callbacks.swap(player.callbacks);
+    }
+    for (auto &callback : callbacks)
+      callback();
+
+    // The miss completes when the queried list has been rendered.
+    if (!callbacks.empty() && !player.queryInFlight) {
+      menu.clear();
+      TrackedPetList pets;
+      if (_cache.Get(player.guid, pets))
+        RenderTrackedPets(pets, menu);
+      Record(result, ACTION_TRACKED_MENU_MISS,
+             Clock::now() - player.queryStart);
+    }
+  }
+
+  void ShowMainMenu(std::vector<MenuItem> &menu) {
+    static char const *const CategoryOptions[MAX_PET_CATEGORIES] = {
+        "Browse Pets", "Browse Exotic Pets", "Browse Rare Pets",
+        "Browse Rare Exotic Pets"};
+    auto catalog = _catalog.Get();
+    for (uint32 category = 0; category < MAX_PET_CATEGORIES; ++category)
+      if (!catalog->GetCategory(BeastmasterPetCategory(category)).empty())
+        menu.push_back(
+            {3, EncodeCatalogPageAction(BeastmasterPetCategory(category), 1),
+             CategoryOptions[category]});
+    menu.push_back({3, EncodeGossipAction(GOSSIP_OPCODE_REMOVE_SKILLS),
+                    "Unlearn Hunter Skills"});
+    menu.push_back({3, EncodeGossipAction(GOSSIP_OPCODE_TRACKED_MENU),
+                    "My Tracked Pets"});
+    menu.push_back(
+        {3, EncodeGossipAction(GOSSIP_OPCODE_STABLE), "Visit Stable"});
+    menu.push_back(
+        {1, EncodeGossipAction(GOSSIP_OPCODE_VENDOR), "Buy Pet Food"});
+  }
+
+  void Browse(SimPlayer &player, std::mt19937 &rng,
+              std::vector<MenuItem> &menu) {
+    auto catalog = _catalog.Get();
+    auto category = BeastmasterPetCategory(rng() % MAX_PET_CATEGORIES);
+    BeastmasterGossipPages const &pages = catalog->GetGossipPages();
+    uint32 page = 1 + rng() % pages.GetPageCount(category);
+    for (auto const &item : pages.GetPage(category, page)) {
+      bool tamed = item.row != BeastmasterGossipItem::NO_ROW &&
+                   player.tamedRows[item.row];
+      menu.push_back({item.icon, item.action,
+                      tamed ? item.tamedText : item.text});
+    }
+  }
+
+  void Adopt(SimPlayer &player, std::mt19937 &rng) {
+    auto catalog = _catalog.Get();
+    auto rows = catalog->GetCategory(PET_CATEGORY_NORMAL);
+    uint32 entry = catalog->GetPet(rows[rng() % rows.size()]).entry;
+    uint32 row = catalog->FindRow(entry);
+    if (row == BeastmasterCatalog::NOT_FOUND || player.tamedRows[row])
+      return;
+
+    // A full list swaps out the oldest pet, to keep adoptions flowing.
+    if (player.tamedEntries.size() >= MAX_TRACKED_PETS) {
+      uint32 oldest = player.tamedEntries.front();
+      player.tamedEntries.erase(player.tamedEntries.begin());
+      if (uint32 oldRow = catalog->FindRow(oldest);
+          oldRow != BeastmasterCatalog::NOT_FOUND)
+        player.tamedRows[oldRow] = false;
+      _journal.Delete(uint32(player.guid), oldest);
+    }
+
+    player.tamedEntries.push_back(entry);
+    player.tamedRows[row] = true;
+    _journal.Insert(uint32(player.guid), entry,
+                    std::string(catalog->GetName(row)), time(nullptr));
+    _cache.Erase(player.guid);
+  }
+
+  // False on a cache miss; the query result renders the page later.
+  bool ShowTrackedPetsMenu(SimPlayer &player, std::vector<MenuItem> &menu) {
+    TrackedPetList pets;
+    if (_cache.Get(player.guid, pets)) {
+      RenderTrackedPets(pets, menu);
+      return true;
+    }
+    if (player.queryInFlight)
+      return false;
+
+    player.queryInFlight = true;
+    player.queryStart = Clock::now();
+    SimPlayer *target = &player;
+    auto callback = [this, target](std::vector<FakeDatabase::Row> rows) {
+      std::lock_guard<BeastmasterMutex> lock(target->callbackLock);
+      target->callbacks.push_back([this, target, rows = std::move(rows)]() {
+        TrackedPetList pets;
+        pets.reserve(rows.size());
+        for (auto const &row : rows)
+          pets.emplace_back(row.entry, row.name, row.tamedAt);
+        BeastmasterTrackedPageBuilder page({}, std::move(pets));
+        ApplyPendingOps(_journal.GetPending(uint32(target->guid)), page);
+        page.Build(pets);
+        _cache.Put(target->guid, std::move(pets));
+        target->queryInFlight = false;
+      });
+    };
+    // The first page, as the module queries it.
+    _db.AsyncQuery(player.guid, TRACKED_PAGE_QUERY_LIMIT, std::move(callback));
+    return false;
+  }
+
+  static void RenderTrackedPets(TrackedPetList const &pets,
+                                std::vector<MenuItem> &menu) {
+    BeastmasterPageSlice slice =
+        GetPageSlice(pets.size(), 1, PET_TRACKED_PAGE_SIZE);
+    for (std::size_t i = slice.first; i < slice.first + slice.count; ++i) {
+      std::string name(pets[i].GetName());
+      uint32 index = uint32(i - slice.first);
+      menu.push_back(
+          {0, EncodeGossipAction(GOSSIP_OPCODE_TRACKED_SUMMON, index),
+           "Summon " + name});
+      menu.push_back(
+          {0, EncodeGossipAction(GOSSIP_OPCODE_TRACKED_RENAME, index),
+           "Rename " + name});
+      menu.push_back(
+          {0, EncodeGossipAction(GOSSIP_OPCODE_TRACKED_DELETE, index),
+           "Delete " + name});
+    }
+  }
+
+  void Rename(SimPlayer &player, std::mt19937 &rng) {
+    std::string const &name = _names[rng() % _names.size()];
+    if (!BeastmasterNameValidator::IsValid(name))
+      return;
+    if (auto filter = _profanity.Get(); filter && filter->Matches(name))
+      return;
+    if (player.tamedEntries.empty())
+      return;
+
+    uint32 entry = player.tamedEntries[rng() % player.tamedEntries.size()];
+    _cache.Modify(player.guid, [entry, &name](TrackedPetList &pets) {
+      for (auto &pet : pets)
+        if (pet.entry == entry)
+          pet.SetName(name);
+    });
+    _journal.Rename(uint32(player.guid), entry, name);
+  }
+
+  // The journal's transaction: one statement applying the whole batch.
+  void WriteBatch(BeastmasterJournalQueue::Batch const &batch) {
+    ++_journalBatches;
+    _journalWrites += batch.size();
+    _db.Execute([this, batch](FakeDatabase::Table &table) {
+      for (auto const &op : batch) {
+        auto &rows = table[op.owner];
+        auto it = std::find_if(rows.begin(), rows.end(),
+                               [&op](FakeDatabase::Row const &row) {
+                                 return row.entry == op.entry;
+                               });
+        switch (op.type) {
+        case BeastmasterJournalQueue::OP_INSERT:
+          if (it == rows.end())
+            rows.insert(rows.begin(), {op.entry, op.name, op.date});
+          break;
+        case BeastmasterJournalQueue::OP_REPLACE:
+          if (it != rows.end())
+            rows.erase(it);
+          rows.insert(rows.begin(), {op.entry, op.name, op.date});
+          break;
+        case BeastmasterJournalQueue::OP_RENAME:
+          if (it != rows.end())
+            it->name = op.name;
+          break;
+        case BeastmasterJournalQueue::OP_DELETE:
+          if (it != rows.end())
+            rows.erase(it);
+          break;
+        }
+      }
+      _journal.Committed();
+    });
+  }
+
+  Options const &_options;
+  FakeDatabase &_db;
+  FakeWorldDatabase const &_world;
+
+  BeastmasterSnapshot<BeastmasterCatalog> _catalog;
+  BeastmasterSnapshot<BeastmasterProfanityFilter> _profanity;
+  BeastmasterCooldowns _cooldowns;
+  BeastmasterTrackedPetsCache _cache;
+  BeastmasterJournalQueue _journal;
+  std::atomic<uint64> _journalBatches = 0;
+  std::atomic<uint64> _journalWrites = 0;
+  BeastmasterTameRowStats _catalogStats; // World thread only
+  uint32 _catalogLoads = 0;
+  double _catalogLoadMs = 0.0;
+  std::vector<std::string> _names;
+  std::vector<std::unique_ptr<SimPlayer>> _players;
+};
+
+bool ParseOption(std::string_view arg, std::string_view name, uint32 &value) {
+  if (!arg.starts_with(name) || arg.size() <= name.size() ||
+      arg[name.size()] != '=')
+    return false;
+  std::string_view text = arg.substr(name.size() + 1);
+  auto [end, error] =
+      std::from_chars(text.data(), text.data() + text.size(), value);
+  return error == std::errc() && end == text.data() + text.size();
+}
+
+bool ParseOptions(int argc, char **argv, Options &options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if (!ParseOption(arg, "--players", options.players) &&
+        !ParseOption(arg, "--threads", options.threads) &&
+        !ParseOption(arg, "--seconds", options.seconds) &&
+        !ParseOption(arg, "--think-ms", options.thinkMs) &&
+        !ParseOption(arg, "--pets", options.pets) &&
+        !ParseOption(arg, "--db-connections", options.dbConnections) &&
+        !ParseOption(arg, "--db-latency-us", options.dbLatencyUs) &&
+        !ParseOption(arg, "--db-jitter-us", options.dbJitterUs) &&
+        !ParseOption(arg, "--flush-ms", options.flushMs) &&
+        !ParseOption(arg, "--catalog-reload-ms", options.catalogReloadMs)) {
+      std::fprintf(stderr, "Unknown option %s\n", argv[i]);
+      return false;
+    }
+  }
+  if (!options.players || !options.threads || !options.dbConnections ||
+      options.pets < 100 || options.players < options.threads) {
+    std::fprintf(stderr, "Need players >= threads >= 1, pets >= 100 and at "
+                         "least one database connection\n");
+    return false;
+  }
+  return true;
+}
+
+double Percentile(std::vector<uint32> const &sorted, double fraction) {
+  if (sorted.empty())
+    return 0.0;
+  std::size_t index = std::min(sorted.size() - 1,
+                               std::size_t(fraction * double(sorted.size())));
+  return sorted[index] / 1000.0;
+}
+
+void PrintLock(char const *name, uint64 contentions, uint64 waitNanoseconds) {
+  std::printf("  %-22s %12llu %12.1f\n", name,
+              (unsigned long long)contentions, double(waitNanoseconds) / 1e6);
+}
+
+void PrintLock(char const *name, BeastmasterLockStats const &stats) {
+  PrintLock(name, stats.contentions, stats.waitNanoseconds);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  if (!ParseOptions(argc, argv, options))
+    return 1;
+
+  std::printf("%u players on %u threads for %u s, %u ms think time, %u pets; "
+              "database: %u connections, %u us latency + up to %u us "
+              "jitter\n\n",
+              options.players, options.threads, options.seconds,
+              options.thinkMs, options.pets, options.dbConnections,
+              options.dbLatencyUs, options.dbJitterUs);
+
+  std::vector<ThreadResult> results(options.threads);
+  double seconds;
+  FakeDatabase db(options.dbConnections,
+                  std::chrono::microseconds(options.dbLatencyUs),
+                  std::chrono::microseconds(options.dbJitterUs));
+  FakeWorldDatabase world(options.pets,
+                          std::chrono::microseconds(options.dbLatencyUs),
+                          WORLD_ROW_TIME);
+  {
+    Simulation simulation(options, db, world);
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = start + std::chrono::seconds(options.seconds);
+    std::vector<std::thread> threads;
+    for (uint32 i = 0; i < options.threads; ++i)
+      threads.emplace_back([&simulation, &results, deadline, i]() {
+        simulation.Run(i, deadline, results[i]);
+      });
+    threads.emplace_back(
+        [&simulation, deadline]() { simulation.RunWorld(deadline); });
+    for (std::thread &thread : threads)
+      thread.join();
+    seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    db.Stop(); // Callbacks point at the simulation's players
+
+    std::printf("  %-28s %10s %10s %9s %9s %9s %9s\n", "action (latency in us)",
+                "ops", "ops/s", "p50", "p99", "p99.9", "max");
+    uint64 totalOps = 0;
+    for (ActionWeight const &entry : ActionTable) {
+      std::vector<uint32> samples;
+      uint64 count = 0;
+      for (ThreadResult &result : results) {
+        samples.insert(samples.end(), result.samples[entry.action].begin(),
+                       result.samples[entry.action].end());
+        count += result.counts[entry.action];
+      }
+      std::sort(samples.begin(), samples.end());
+      totalOps += count;
+      std::printf("  %-28s %10llu %10.0f %9.2f %9.2f %9.2f %9.2f\n",
+                  entry.name, (unsigned long long)count, count / seconds,
+                  Percentile(samples, 0.50), Percentile(samples, 0.99),
+                  Percentile(samples, 0.999),
+                  samples.empty() ? 0.0 : samples.back() / 1000.0);
+    }
+    std::printf("  %-28s %10llu %10.0f\n\n", "total",
+                (unsigned long long)totalOps, totalOps / seconds);
+
+    auto cache = simulation.GetCacheStats();
+    std::printf("tracked pets cache: %llu hits, %llu misses, %llu evictions, "
+                "%zu lists in %zu bytes\n",
+                (unsigned long long)cache.hits,
+                (unsigned long long)cache.misses,
+                (unsigned long long)cache.evictions, cache.lists, cache.bytes);
+    std::printf("database: %llu statements, %.2f ms average queue wait, "
+                "%llu still queued at the end\n",
+                (unsigned long long)db.GetStatementCount(),
+                db.GetAverageQueueWaitMs(),
+                (unsigned long long)db.GetDroppedCount());
+    uint64 batches = simulation.GetJournalBatches();
+    std::printf("journal: %llu batches of %.1f writes on average, %zu "
+                "writes still pending\n",
+                (unsigned long long)batches,
+                batches ? double(simulation.GetJournalWrites()) / batches
+                        : 0.0,
+                simulation.GetJournalPending());
+    if (options.catalogReloadMs)
+      std::printf("catalog: %u loads, %.2f ms on average\n",
+                  simulation.GetCatalogLoads(),
+                  simulation.GetAverageCatalogLoadMs());
+    std::printf("\n");
+
+    std::printf("  %-22s %12s %12s\n", "lock contention", "waits",
+                "waited ms");
+    PrintLock(GetLockSiteName(LOCK_SITE_TRACKED_PETS_CACHE),
+              GetLockStats(LOCK_SITE_TRACKED_PETS_CACHE));
+    PrintLock(GetLockSiteName(LOCK_SITE_COOLDOWNS),
+              GetLockStats(LOCK_SITE_COOLDOWNS));
+    PrintLock(GetLockSiteName(LOCK_SITE_JOURNAL),
+              GetLockStats(LOCK_SITE_JOURNAL));
+    uint64 contentions, waitNanoseconds;
+    simulation.GetCallbackLockStats(contentions, waitNanoseconds);
+    PrintLock("session callbacks", contentions, waitNanoseconds);
+    PrintLock("database queue", db.queueLockStats);
+    PrintLock("database table", db.tableLockStats);
+  }
+  return 0;
+}
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+"""Compares a benchmark run against a stored baseline.
+
+    beastmaster_bench --benchmark_out=run.json --benchmark_out_format=json
+    bench/compare.py bench/baselines/<machine>.json run.json
+
+Prints the change in real time per benchmark and exits with status 1 if any
+benchmark got slower than the threshold (default 10%). Only compare runs
+from the same machine.
+"""
+
+import argparse
+import json
+import sys
+
+UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path):
+    with open(path) as f:
+        runs = json.load(f)["benchmarks"]
+    return {
+        run["name"]: run["real_time"] * UNITS[run["time_unit"]]
+        for run in runs
+        if run.get("run_type", "iteration") == "iteration"
+    }
+
+
+def format_ns(ns):
+    for unit in ("s", "ms", "us"):
+        if ns >= UNITS[unit]:
+            return f"{ns / UNITS[unit]:.3g} {unit}"
+    return f"{ns:.3g} ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("run")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="allowed slowdown as a fraction (default 0.10)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    run = load(args.run)
+
+    regressions = 0
+    width = max(map(len, run), default=0)
+    for name, ns in run.items():
+        if name not in baseline:
+            print(f"{name:<{width}}  {format_ns(ns):>10}  (new)")
+            continue
+        change = ns / baseline[name] - 1.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(f"{name:<{width}}  {format_ns(baseline[name]):>10} -> "
+              f"{format_ns(ns):>10}  {change:+7.1%}{flag}")
+
+    for name in baseline.keys() - run.keys():
+        print(f"{name:<{width}}  (missing from run)")
+
+    if regressions:
+        print(f"{regressions} benchmark(s) slower than "
+              f"{args.threshold:.0%}", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
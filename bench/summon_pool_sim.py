@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""Event simulation of .beastmaster summons in one busy zone.
+
+    bench/summon_pool_sim.py [--players=60] [--minutes=30] [--seed=42]
+
+Players call .beastmaster at random (on average every 3 minutes), most of
+them near one of a few hotspots such as a bank or flight master. The
+command is replayed the way BeastMaster_CommandScript handles it: a pooled
+summon within reuse range is pointed to, then the map and zone caps are
+checked, then the per-player cooldown. Prints the peak and time-averaged
+number of summoned Beastmasters alive, and how many were summoned, for
+each pooling mode.
+"""
+
+import argparse
+import heapq
+import math
+import random
+
+ZONE_SIZE = 600.0  # yards
+HOTSPOTS = [(150.0, 200.0), (300.0, 320.0), (420.0, 180.0)]
+HOTSPOT_SHARE = 0.7
+HOTSPOT_SPREAD = 8.0  # yards, standard deviation around a hotspot
+MEAN_CALL_INTERVAL = 180.0  # seconds
+COOLDOWN = 120.0  # BeastMaster.SummonCooldown
+LIFETIME = 120.0  # The summon's despawn timer
+REUSE_RANGE = 20.0  # BeastMaster.SummonPool.ReuseRange
+
+MODES = [
+    # name, pooling, per map cap, per zone cap (0 = no limit)
+    ("no pool", False, 0, 0),
+    ("reuse only, no caps", True, 0, 0),
+    ("reuse + caps 10/5", True, 10, 5),
+]
+
+
+def make_calls(players, seconds, rng):
+    calls = []
+    for player in range(players):
+        t = rng.expovariate(1.0 / MEAN_CALL_INTERVAL)
+        while t < seconds:
+            if rng.random() < HOTSPOT_SHARE:
+                hx, hy = rng.choice(HOTSPOTS)
+                pos = (rng.gauss(hx, HOTSPOT_SPREAD),
+                       rng.gauss(hy, HOTSPOT_SPREAD))
+            else:
+                pos = (rng.uniform(0, ZONE_SIZE), rng.uniform(0, ZONE_SIZE))
+            calls.append((t, player, pos))
+            t += rng.expovariate(1.0 / MEAN_CALL_INTERVAL)
+    calls.sort()
+    return calls
+
+
+def simulate(calls, seconds, pooling, max_per_map, max_per_zone):
+    # The zone is the whole map here, so the lower cap applies.
+    caps = [c for c in (max_per_map, max_per_zone) if c]
+    cap = min(caps) if caps else 0
+
+    alive = []  # (despawn time, position), a heap
+    cooldowns = {}
+    summons = 0
+    peak = 0
+    area = 0.0  # integral of the alive count over time
+    last = 0.0
+
+    def advance(now):
+        nonlocal area, last
+        while alive and alive[0][0] <= now:
+            despawn = alive[0][0]
+            area += (despawn - last) * len(alive)
+            last = despawn
+            heapq.heappop(alive)
+        area += (now - last) * len(alive)
+        last = now
+
+    for t, player, pos in calls:
+        advance(t)
+        if pooling and any(math.dist(pos, p) <= REUSE_RANGE for _, p in alive):
+            continue
+        if pooling and cap and len(alive) >= cap:
+            continue
+        if cooldowns.get(player, -COOLDOWN) + COOLDOWN > t:
+            continue
+        cooldowns[player] = t
+        heapq.heappush(alive, (t + LIFETIME, pos))
+        summons += 1
+        peak = max(peak, len(alive))
+
+    advance(seconds)
+    return peak, area / seconds, summons
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--players", type=int, default=60)
+    parser.add_argument("--minutes", type=int, default=30)
+    parser.add_argument("--seed", type=int, default=42)
+    args = parser.parse_args()
+
+    seconds = args.minutes * 60.0
+    calls = make_calls(args.players, seconds, random.Random(args.seed))
+    print(f"{args.players} players, {args.minutes} minutes, "
+          f"{len(calls)} calls\n")
+    print(f"  {'mode':<22}{'peak':>6}{'average':>9}{'summons':>9}")
+    for name, pooling, max_per_map, max_per_zone in MODES:
+        peak, average, summons = simulate(calls, seconds, pooling,
+                                          max_per_map, max_per_zone)
+        print(f"  {name:<22}{peak:>6}{average:>9.1f}{summons:>9}")
+
+
+if __name__ == "__main__":
+    main()
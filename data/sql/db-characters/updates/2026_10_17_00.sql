@@ -0,0 +1,15 @@
+-- Tracked pets menu pages seek (owner_guid, date_tamed, entry) instead of
+-- sorting every pet of the owner. Skipped if the index is already there.
+SET @index_exists := (
+    SELECT COUNT(*) FROM information_schema.statistics
+    WHERE table_schema = DATABASE()
+      AND table_name = 'beastmaster_tamed_pets'
+      AND index_name = 'idx_beastmaster_tamed_pets_owner_date');
+
+SET @sql := IF(@index_exists = 0,
+    'ALTER TABLE `beastmaster_tamed_pets` ADD KEY `idx_beastmaster_tamed_pets_owner_date` (`owner_guid`, `date_tamed`, `entry`)',
+    'DO 0');
+
+PREPARE stmt FROM @sql;
+EXECUTE stmt;
+DEALLOCATE PREPARE stmt;
@@ -0,0 +1,134 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterConfig.h"
+#include "Config.h"
+#include <algorithm>
+#include <sstream>
+
+static std::set<uint32> ParseEntryList(const std::string &csv) {
+  std::set<uint32> result;
+  std::stringstream ss(csv);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    try {
+      result.insert(std::stoul(item));
+    } catch (...) {
+    }
+  }
+  return result;
+}
+
+// Parses a comma-separated list of class or race ids into a bit mask.
+static uint32 ParseIdMask(const std::string &csv) {
+  uint32 mask = 0;
+  for (uint32 id : ParseEntryList(csv))
+    if (id > 0 && id <= 32)
+      mask |= 1u << (id - 1);
+  return mask;
+}
+
+/*static*/ std::shared_ptr<BeastmasterConfig const>
+BeastmasterConfig::Load(uint32 version) {
+  auto config = std::make_shared<BeastmasterConfig>();
+  config->version = version;
+
+  config->enabled = sConfigMgr->GetOption<bool>("BeastMaster.Enable", true);
+  config->showLoginNotice =
+      sConfigMgr->GetOption<bool>("BeastMaster.ShowLoginNotice", true);
+  config->loginMessage =
+      sConfigMgr->GetOption<std::string>("BeastMaster.LoginMessage", "");
+
+  config->hunterOnly =
+      sConfigMgr->GetOption<bool>("BeastMaster.HunterOnly", true);
+  config->allowedClassMask = ParseIdMask(
+      sConfigMgr->GetOption<std::string>("BeastMaster.AllowedClasses", "0"));
+  config->allowedRaceMask = ParseIdMask(
+      sConfigMgr->GetOption<std::string>("BeastMaster.AllowedRaces", "0"));
+  config->minLevel = sConfigMgr->GetOption<uint32>("BeastMaster.MinLevel", 10);
+  config->maxLevel = sConfigMgr->GetOption<uint32>("BeastMaster.MaxLevel", 0);
+  config->hunterBeastMasteryRequired = sConfigMgr->GetOption<bool>(
+      "BeastMaster.HunterBeastMasteryRequired", true);
+  config->allowExotic =
+      sConfigMgr->GetOption<bool>("BeastMaster.AllowExotic", false);
+
+  config->keepPetHappy =
+      sConfigMgr->GetOption<bool>("BeastMaster.KeepPetHappy", false);
+  config->keepPetHappyInterval =
+      sConfigMgr->GetOption<uint32>("BeastMaster.KeepPetHappy.Interval", 5000);
+  config->keepPetHappyThreshold = std::min<uint32>(
+      sConfigMgr->GetOption<uint32>("BeastMaster.KeepPetHappy.Threshold", 90),
+      100);
+
+  config->trackTamedPets =
+      sConfigMgr->GetOption<bool>("BeastMaster.TrackTamedPets", false);
+  config->maxTrackedPets =
+      sConfigMgr->GetOption<uint32>("BeastMaster.MaxTrackedPets", 20);
+  config->journalFlushInterval =
+      sConfigMgr->GetOption<uint32>("BeastMaster.Journal.FlushInterval", 1000);
+  config->trackedPetsCacheBudget = sConfigMgr->GetOption<uint32>(
+      "BeastMaster.TrackedPetsCache.MemoryBudget", 4096);
+
+  config->namePolicy.maxConsecutiveSpaces = sConfigMgr->GetOption<uint32>(
+      "BeastMaster.PetName.MaxConsecutiveSpaces", 0);
+  config->namePolicy.maxConsecutiveApostrophes = sConfigMgr->GetOption<uint32>(
+      "BeastMaster.PetName.MaxConsecutiveApostrophes", 0);
+  config->namePolicy.minLetters =
+      sConfigMgr->GetOption<uint32>("BeastMaster.PetName.MinLetters", 0);
+  config->namePolicy.allowUtf8Letters = sConfigMgr->GetOption<bool>(
+      "BeastMaster.PetName.AllowUtf8Letters", false);
+
+  config->profanityFilter =
+      sConfigMgr->GetOption<bool>("BeastMaster.ProfanityFilter", true);
+  config->profanityFile = sConfigMgr->GetOption<std::string>(
+      "BeastMaster.ProfanityFilter.File",
+      "modules/mod-npc-beastmaster/conf/profanity.txt");
+  config->profanityLeetspeak = sConfigMgr->GetOption<bool>(
+      "BeastMaster.ProfanityFilter.Leetspeak", true);
+  config->profanityCheckInterval = sConfigMgr->GetOption<uint32>(
+      "BeastMaster.ProfanityFilter.CheckInterval", 10000);
+  config->summonCooldown =
+      sConfigMgr->GetOption<uint32>("BeastMaster.SummonCooldown", 120);
+  config->summonPool =
+      sConfigMgr->GetOption<bool>("BeastMaster.SummonPool.Enable", false);
+  config->summonPoolReuseRange = sConfigMgr->GetOption<float>(
+      "BeastMaster.SummonPool.ReuseRange", 20.0f);
+  config->summonPoolMaxPerMap =
+      sConfigMgr->GetOption<uint32>("BeastMaster.SummonPool.MaxPerMap", 10);
+  config->summonPoolMaxPerZone =
+      sConfigMgr->GetOption<uint32>("BeastMaster.SummonPool.MaxPerZone", 5);
+  config->npcEntry =
+      sConfigMgr->GetOption<uint32>("BeastMaster.NpcEntry", 601026);
+  config->catalogFile =
+      sConfigMgr->GetOption<std::string>("BeastMaster.CatalogFile", "");
+  config->metrics =
+      sConfigMgr->GetOption<bool>("BeastMaster.Metrics.Enable", true);
+  config->metricsExportFile = sConfigMgr->GetOption<std::string>(
+      "BeastMaster.Metrics.ExportFile", "");
+  config->metricsExportInterval = std::max<uint32>(
+      sConfigMgr->GetOption<uint32>("BeastMaster.Metrics.ExportInterval",
+                                    15000),
+      1000);
+
+  config->rarePetEntries = ParseEntryList(
+      sConfigMgr->GetOption<std::string>("BeastMaster.RarePets", ""));
+  config->rareExoticPetEntries = ParseEntryList(
+      sConfigMgr->GetOption<std::string>("BeastMaster.RareExoticPets", ""));
+
+  return config;
+}
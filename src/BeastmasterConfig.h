@@ -0,0 +1,96 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_CONFIG_H_
+#define _BEASTMASTER_CONFIG_H_
+
+#include "BeastmasterNameValidator.h"
+#include "Common.h"
+#include <memory>
+#include <set>
+#include <string>
+
+/**
+ * BeastmasterConfig
+ * Immutable snapshot of every BeastMaster.* option.
+ * A new snapshot is built on each (re)load and published atomically, so hot
+ * paths read plain fields instead of going through sConfigMgr.
+ */
+struct BeastmasterConfig {
+  uint32 version = 0;
+
+  bool enabled = true;
+  bool showLoginNotice = true;
+  std::string loginMessage;
+
+  bool hunterOnly = true;
+  // Bit (id - 1) set for every allowed class/race; 0 means all allowed.
+  uint32 allowedClassMask = 0;
+  uint32 allowedRaceMask = 0;
+  uint32 minLevel = 10;
+  uint32 maxLevel = 0;
+  bool hunterBeastMasteryRequired = true;
+  bool allowExotic = false;
+
+  bool keepPetHappy = false;
+  uint32 keepPetHappyInterval = 5000;
+  uint32 keepPetHappyThreshold = 90;
+
+  bool trackTamedPets = false;
+  uint32 maxTrackedPets = 20;
+  uint32 journalFlushInterval = 1000;
+  uint32 trackedPetsCacheBudget = 4096; // KiB
+
+  BeastmasterNamePolicy namePolicy;
+
+  bool profanityFilter = true;
+  std::string profanityFile = "modules/mod-npc-beastmaster/conf/profanity.txt";
+  bool profanityLeetspeak = true;
+  uint32 profanityCheckInterval = 10000;
+  uint32 summonCooldown = 120;
+  bool summonPool = false;
+  float summonPoolReuseRange = 20.0f;
+  uint32 summonPoolMaxPerMap = 10;
+  uint32 summonPoolMaxPerZone = 5;
+  uint32 npcEntry = 601026;
+  std::string catalogFile; // Empty disables the saved catalog
+  bool metrics = true;
+  std::string metricsExportFile; // Empty disables the export
+  uint32 metricsExportInterval = 15000;
+
+  std::set<uint32> rarePetEntries;
+  std::set<uint32> rareExoticPetEntries;
+
+  bool IsClassAllowed(uint8 classId) const {
+    return !allowedClassMask ||
+           (classId && classId <= 32 &&
+            (allowedClassMask & (1u << (classId - 1))));
+  }
+
+  bool IsRaceAllowed(uint8 raceId) const {
+    return !allowedRaceMask || (raceId && raceId <= 32 &&
+                                (allowedRaceMask & (1u << (raceId - 1))));
+  }
+
+  /**
+   * Reads all options from sConfigMgr into a new snapshot.
+   */
+  static std::shared_ptr<BeastmasterConfig const> Load(uint32 version);
+};
+
+#endif // _BEASTMASTER_CONFIG_H_
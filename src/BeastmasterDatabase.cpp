@@ -0,0 +1,212 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterDatabase.h"
+#include "BeastmasterMetrics.h"
+#include "Errors.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace {
+enum BeastmasterDatabaseId { BM_DATABASE_CHARACTER, BM_DATABASE_WORLD };
+
+struct StatementInfo {
+  BeastmasterStatements id;
+  BeastmasterDatabaseId database;
+  BeastmasterMetric metric; // Writes are timed by the journal commit
+  char const *site;         // Call site label for the exported counts
+  char const *sql;
+};
+
+// clang-format off
+constexpr StatementInfo StatementCatalog[MAX_BEASTMASTER_STATEMENTS] = {
+    {BM_CHAR_SEL_TAMED_PET_ENTRIES, BM_DATABASE_CHARACTER,
+     METRIC_DB_TAMED_PET_ENTRIES, "player_state",
+     "SELECT entry FROM beastmaster_tamed_pets WHERE owner_guid = ?"},
+    // Tracked pets pages seek the (owner_guid, date_tamed, entry) index.
+    {BM_CHAR_SEL_TAMED_PETS, BM_DATABASE_CHARACTER, METRIC_DB_TAMED_PETS,
+     "tracked_pets_menu",
+     "SELECT entry, name, UNIX_TIMESTAMP(date_tamed) "
+     "FROM beastmaster_tamed_pets WHERE owner_guid = ? "
+     "ORDER BY date_tamed DESC, entry DESC LIMIT ?"},
+    {BM_CHAR_SEL_TAMED_PETS_AFTER, BM_DATABASE_CHARACTER, METRIC_DB_TAMED_PETS,
+     "tracked_pets_next",
+     "SELECT entry, name, UNIX_TIMESTAMP(date_tamed) "
+     "FROM beastmaster_tamed_pets WHERE owner_guid = ? "
+     "AND (date_tamed < FROM_UNIXTIME(?) "
+     "OR (date_tamed = FROM_UNIXTIME(?) AND entry < ?)) "
+     "ORDER BY date_tamed DESC, entry DESC LIMIT ?"},
+    {BM_CHAR_SEL_TAMED_PETS_BEFORE, BM_DATABASE_CHARACTER, METRIC_DB_TAMED_PETS,
+     "tracked_pets_previous",
+     "SELECT entry, name, UNIX_TIMESTAMP(date_tamed) "
+     "FROM beastmaster_tamed_pets WHERE owner_guid = ? "
+     "AND (date_tamed > FROM_UNIXTIME(?) "
+     "OR (date_tamed = FROM_UNIXTIME(?) AND entry > ?)) "
+     "ORDER BY date_tamed, entry LIMIT ?"},
+    {BM_CHAR_INS_TAMED_PET, BM_DATABASE_CHARACTER, MAX_METRICS,
+     "journal_insert",
+     "INSERT IGNORE INTO beastmaster_tamed_pets "
+     "(owner_guid, entry, name, date_tamed) "
+     "VALUES (?, ?, ?, FROM_UNIXTIME(?))"},
+    {BM_CHAR_REP_TAMED_PET, BM_DATABASE_CHARACTER, MAX_METRICS,
+     "journal_replace",
+     "REPLACE INTO beastmaster_tamed_pets "
+     "(owner_guid, entry, name, date_tamed) "
+     "VALUES (?, ?, ?, FROM_UNIXTIME(?))"},
+    {BM_CHAR_UPD_TAMED_PET_NAME, BM_DATABASE_CHARACTER, MAX_METRICS,
+     "journal_rename",
+     "UPDATE beastmaster_tamed_pets SET name = ? "
+     "WHERE owner_guid = ? AND entry = ?"},
+    {BM_CHAR_DEL_TAMED_PET, BM_DATABASE_CHARACTER, MAX_METRICS,
+     "journal_delete",
+     "DELETE FROM beastmaster_tamed_pets WHERE owner_guid = ? AND entry = ?"},
+    {BM_WORLD_SEL_TAMES, BM_DATABASE_WORLD, METRIC_DB_TAMES, "catalog",
+     "SELECT t.entry, t.name, t.family, t.rarity, c.type_flags "
+     "FROM beastmaster_tames t "
+     "LEFT JOIN creature_template c ON c.entry = t.entry"},
+    {BM_WORLD_SEL_TAMES_CHECKSUM, BM_DATABASE_WORLD, METRIC_DB_TAMES_CHECKSUM,
+     "catalog_checksum",
+     "SELECT COUNT(*), CAST(COALESCE(SUM(crc), 0) AS UNSIGNED), "
+     "COALESCE(BIT_XOR(crc), 0) FROM ("
+     "SELECT CRC32(CONCAT_WS(',', t.entry, t.name, t.family, t.rarity, "
+     "COALESCE(c.type_flags, ''))) AS crc "
+     "FROM beastmaster_tames t "
+     "LEFT JOIN creature_template c ON c.entry = t.entry) AS tames"},
+};
+// clang-format on
+
+// SQL text around each placeholder: N placeholders give N + 1 fragments.
+std::array<std::vector<std::string>, MAX_BEASTMASTER_STATEMENTS> Fragments;
+std::once_flag FragmentsLoaded;
+
+std::array<std::atomic<uint64>, MAX_BEASTMASTER_STATEMENTS> IssuedCounts{};
+
+void SplitStatements() {
+  for (StatementInfo const &info : StatementCatalog) {
+    ASSERT(info.id < MAX_BEASTMASTER_STATEMENTS);
+    std::vector<std::string> &fragments = Fragments[info.id];
+    fragments.emplace_back();
+    for (char const *c = info.sql; *c; ++c) {
+      if (*c == '?')
+        fragments.emplace_back();
+      else
+        fragments.back() += *c;
+    }
+  }
+}
+
+StatementInfo const &GetInfo(BeastmasterStatements id) {
+  ASSERT(id < MAX_BEASTMASTER_STATEMENTS && StatementCatalog[id].id == id);
+  return StatementCatalog[id];
+}
+} // namespace
+
+BeastmasterStatement::BeastmasterStatement(BeastmasterStatements id)
+    : _id(id) {
+  BeastmasterDB::LoadStatements();
+  _params.resize(Fragments[id].size() - 1);
+}
+
+void BeastmasterStatement::SetData(uint8 index, uint32 value) {
+  ASSERT(index < _params.size());
+  _params[index] = std::to_string(value);
+}
+
+void BeastmasterStatement::SetData(uint8 index, std::string const &value) {
+  ASSERT(index < _params.size());
+  std::string escaped = value;
+  if (GetInfo(_id).database == BM_DATABASE_WORLD)
+    WorldDatabase.EscapeString(escaped);
+  else
+    CharacterDatabase.EscapeString(escaped);
+  _params[index] = "'" + escaped + "'";
+}
+
+std::string BeastmasterStatement::GetSql() const {
+  std::vector<std::string> const &fragments = Fragments[_id];
+
+  std::size_t length = 0;
+  for (std::string const &fragment : fragments)
+    length += fragment.size();
+  for (std::string const &param : _params)
+    length += param.size();
+
+  std::string sql;
+  sql.reserve(length);
+  for (std::size_t i = 0; i < _params.size(); ++i) {
+    sql += fragments[i];
+    sql += _params[i];
+  }
+  sql += fragments.back();
+  return sql;
+}
+
+namespace BeastmasterDB {
+void LoadStatements() { std::call_once(FragmentsLoaded, SplitStatements); }
+
+QueryResult Query(BeastmasterStatement const &stmt) {
+  StatementInfo const &info = GetInfo(stmt.GetId());
+  IssuedCounts[info.id].fetch_add(1, std::memory_order_relaxed);
+  BeastmasterTimer timer(info.metric);
+  if (info.database == BM_DATABASE_WORLD)
+    return WorldDatabase.Query(stmt.GetSql());
+  return CharacterDatabase.Query(stmt.GetSql());
+}
+
+void Execute(BeastmasterStatement const &stmt) {
+  IssuedCounts[stmt.GetId()].fetch_add(1, std::memory_order_relaxed);
+  if (GetInfo(stmt.GetId()).database == BM_DATABASE_WORLD)
+    WorldDatabase.Execute(stmt.GetSql());
+  else
+    CharacterDatabase.Execute(stmt.GetSql());
+}
+
+QueryCallback AsyncQuery(BeastmasterStatement const &stmt,
+                         std::function<void(QueryResult)> callback) {
+  StatementInfo const &info = GetInfo(stmt.GetId());
+  IssuedCounts[info.id].fetch_add(1, std::memory_order_relaxed);
+
+  // Timed until the callback runs, as that is when the result is usable.
+  auto start = BeastmasterMetrics::Start();
+  auto timed = [metric = info.metric, start,
+                callback = std::move(callback)](QueryResult result) {
+    BeastmasterMetrics::RecordSince(metric, start);
+    callback(std::move(result));
+  };
+
+  if (info.database == BM_DATABASE_WORLD)
+    return WorldDatabase.AsyncQuery(stmt.GetSql()).WithCallback(
+        std::move(timed));
+  return CharacterDatabase.AsyncQuery(stmt.GetSql()).WithCallback(
+      std::move(timed));
+}
+
+void Append(CharacterDatabaseTransaction &trans,
+            BeastmasterStatement const &stmt) {
+  ASSERT(GetInfo(stmt.GetId()).database == BM_DATABASE_CHARACTER);
+  IssuedCounts[stmt.GetId()].fetch_add(1, std::memory_order_relaxed);
+  trans->Append(stmt.GetSql());
+}
+
+uint64 GetIssuedCount(BeastmasterStatements id) {
+  return IssuedCounts[GetInfo(id).id].load(std::memory_order_relaxed);
+}
+
+char const *GetCallSite(BeastmasterStatements id) { return GetInfo(id).site; }
+} // namespace BeastmasterDB
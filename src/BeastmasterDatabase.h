@@ -0,0 +1,99 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_DATABASE_H_
+#define _BEASTMASTER_DATABASE_H_
+
+#include "Common.h"
+#include "DatabaseEnv.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Statement catalog: every query the module issues, listed once in
+ * BeastmasterDatabase.cpp with its database, call site and metric, and
+ * split at its '?' placeholders once at startup.
+ *
+ * This is not server-side preparation; see BeastmasterStatement. The
+ * catalog keeps the SQL in one place, escapes string parameters and counts
+ * and times each statement.
+ */
+enum BeastmasterStatements : uint32 {
+  // Characters database
+  BM_CHAR_SEL_TAMED_PET_ENTRIES, // owner_guid
+  BM_CHAR_SEL_TAMED_PETS,        // owner_guid, limit
+  BM_CHAR_SEL_TAMED_PETS_AFTER,  // owner_guid, date_tamed x2, entry, limit
+  BM_CHAR_SEL_TAMED_PETS_BEFORE, // owner_guid, date_tamed x2, entry, limit
+  BM_CHAR_INS_TAMED_PET,         // owner_guid, entry, name, date_tamed
+  BM_CHAR_REP_TAMED_PET,         // owner_guid, entry, name, date_tamed
+  BM_CHAR_UPD_TAMED_PET_NAME,    // name, owner_guid, entry
+  BM_CHAR_DEL_TAMED_PET,         // owner_guid, entry
+
+  // World database
+  BM_WORLD_SEL_TAMES,
+  BM_WORLD_SEL_TAMES_CHECKSUM,
+
+  MAX_BEASTMASTER_STATEMENTS
+};
+
+/**
+ * BeastmasterStatement
+ * A catalogued statement with its parameters bound. Mirrors the core's
+ * PreparedStatement API; string parameters are escaped and quoted when
+ * bound, so names containing apostrophes are stored as typed.
+ *
+ * AzerothCore prepares server-side statements per database from a fixed
+ * core enum, which modules cannot extend, so the bound statement is sent
+ * and parsed as plain text, like the fmt-built queries it replaced.
+ */
+class BeastmasterStatement {
+public:
+  explicit BeastmasterStatement(BeastmasterStatements id);
+
+  void SetData(uint8 index, uint32 value);
+  void SetData(uint8 index, std::string const &value);
+
+  BeastmasterStatements GetId() const { return _id; }
+
+  // The statement with all parameters substituted.
+  std::string GetSql() const;
+
+private:
+  BeastmasterStatements _id;
+  std::vector<std::string> _params;
+};
+
+namespace BeastmasterDB {
+// Splits the statement table; called once before the first query.
+void LoadStatements();
+
+// Reads are timed per statement (see BeastmasterMetrics).
+QueryResult Query(BeastmasterStatement const &stmt);
+void Execute(BeastmasterStatement const &stmt);
+QueryCallback AsyncQuery(BeastmasterStatement const &stmt,
+                         std::function<void(QueryResult)> callback);
+void Append(CharacterDatabaseTransaction &trans,
+            BeastmasterStatement const &stmt);
+
+// Statements issued since startup, and where the statement is issued from.
+uint64 GetIssuedCount(BeastmasterStatements id);
+char const *GetCallSite(BeastmasterStatements id);
+} // namespace BeastmasterDB
+
+#endif // _BEASTMASTER_DATABASE_H_
@@ -0,0 +1,254 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterExporter.h"
+#include "BeastmasterDatabase.h"
+#include "BeastmasterMetrics.h"
+#include "BeastmasterMutex.h"
+#include "Log.h"
+#include "NpcBeastmaster.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace {
+void WriteHeader(std::ostream &out, char const *name, char const *type,
+                 char const *help) {
+  out << "# HELP " << name << ' ' << help << '\n'
+      << "# TYPE " << name << ' ' << type << '\n';
+}
+
+template <typename T>
+void WriteValue(std::ostream &out, char const *name, T value) {
+  out << name << ' ' << value << '\n';
+}
+
+template <typename T>
+void WriteValue(std::ostream &out, char const *name, char const *label,
+                char const *labelValue, T value) {
+  out << name << '{' << label << "=\"" << labelValue << "\"} " << value
+      << '\n';
+}
+
+void WriteAdoptions(std::ostream &out) {
+  constexpr char const *Categories[] = {"normal", "exotic", "rare",
+                                        "rare_exotic"};
+  WriteHeader(out, "beastmaster_adoptions_total", "counter",
+              "Pets adopted from the beastmaster, by catalog category.");
+  for (uint32 i = 0; i < std::size(Categories); ++i)
+    WriteValue(out, "beastmaster_adoptions_total", "category", Categories[i],
+               BeastmasterMetrics::GetCount(
+                   BeastmasterCounter(COUNTER_ADOPTIONS_NORMAL + i)));
+
+  WriteHeader(out, "beastmaster_summon_cooldown_rejections_total", "counter",
+              "Beastmaster summons refused because of the cooldown.");
+  WriteValue(out, "beastmaster_summon_cooldown_rejections_total",
+             BeastmasterMetrics::GetCount(COUNTER_SUMMON_COOLDOWN_REJECTIONS));
+  WriteHeader(out, "beastmaster_profanity_rejections_total", "counter",
+              "Pet renames refused by the profanity filter.");
+  WriteValue(out, "beastmaster_profanity_rejections_total",
+             BeastmasterMetrics::GetCount(COUNTER_PROFANITY_REJECTIONS));
+}
+
+void WriteTrackedPetsCache(std::ostream &out) {
+  auto stats = sNpcBeastMaster->GetTrackedPetsCache().GetStats();
+  uint64 lookups = stats.hits + stats.misses;
+
+  WriteHeader(out, "beastmaster_tracked_pets_cache_lists", "gauge",
+              "Tracked pet lists in the cache.");
+  WriteValue(out, "beastmaster_tracked_pets_cache_lists", stats.lists);
+  WriteHeader(out, "beastmaster_tracked_pets_cache_bytes", "gauge",
+              "Memory used by cached tracked pet lists.");
+  WriteValue(out, "beastmaster_tracked_pets_cache_bytes", stats.bytes);
+  WriteHeader(out, "beastmaster_tracked_pets_cache_budget_bytes", "gauge",
+              "Memory budget of the tracked pets cache.");
+  WriteValue(out, "beastmaster_tracked_pets_cache_budget_bytes",
+             stats.budget);
+  WriteHeader(out, "beastmaster_tracked_pets_cache_hits_total", "counter",
+              "Tracked pets menu lookups served from the cache.");
+  WriteValue(out, "beastmaster_tracked_pets_cache_hits_total", stats.hits);
+  WriteHeader(out, "beastmaster_tracked_pets_cache_misses_total", "counter",
+              "Tracked pets menu lookups that queried the database.");
+  WriteValue(out, "beastmaster_tracked_pets_cache_misses_total",
+             stats.misses);
+  WriteHeader(out, "beastmaster_tracked_pets_cache_evictions_total",
+              "counter", "Lists evicted to stay within the budget.");
+  WriteValue(out, "beastmaster_tracked_pets_cache_evictions_total",
+             stats.evictions);
+  WriteHeader(out, "beastmaster_tracked_pets_cache_hit_ratio", "gauge",
+              "Share of lookups served from the cache since startup.");
+  WriteValue(out, "beastmaster_tracked_pets_cache_hit_ratio",
+             lookups ? double(stats.hits) / double(lookups) : 0.0);
+}
+
+void WriteDatabase(std::ostream &out) {
+  WriteHeader(out, "beastmaster_db_statements_total", "counter",
+              "Database statements issued, by call site.");
+  for (uint32 i = 0; i < MAX_BEASTMASTER_STATEMENTS; ++i) {
+    auto id = BeastmasterStatements(i);
+    WriteValue(out, "beastmaster_db_statements_total", "site",
+               BeastmasterDB::GetCallSite(id),
+               BeastmasterDB::GetIssuedCount(id));
+  }
+
+  WriteHeader(out, "beastmaster_journal_pending_writes", "gauge",
+              "Tracked pet writes waiting for the next journal flush.");
+  WriteValue(out, "beastmaster_journal_pending_writes",
+             sNpcBeastMaster->GetJournal().GetPendingCount());
+}
+
+void WriteCatalog(std::ostream &out) {
+  auto catalog = sNpcBeastMaster->GetCatalog();
+  WriteHeader(out, "beastmaster_catalog_pets", "gauge",
+              "Adoptable pets in the current catalog.");
+  WriteValue(out, "beastmaster_catalog_pets", catalog->GetSize());
+  WriteHeader(out, "beastmaster_catalog_bytes", "gauge",
+              "Memory used by the current catalog.");
+  WriteValue(out, "beastmaster_catalog_bytes", catalog->GetMemoryUsage());
+  WriteHeader(out, "beastmaster_catalog_mapped", "gauge",
+              "1 if the catalog was mapped from BeastMaster.CatalogFile.");
+  WriteValue(out, "beastmaster_catalog_mapped", catalog->IsMapped() ? 1 : 0);
+  WriteHeader(out, "beastmaster_catalog_load_duration_seconds", "gauge",
+              "Duration of the last catalog load or reload.");
+  WriteValue(out, "beastmaster_catalog_load_duration_seconds",
+             sNpcBeastMaster->GetCatalogLoadTime() / 1000.0);
+}
+
+void WriteLocks(std::ostream &out) {
+  WriteHeader(out, "beastmaster_lock_contentions_total", "counter",
+              "Lock acquisitions that had to wait, by lock.");
+  for (uint32 i = 0; i < MAX_LOCK_SITES; ++i) {
+    auto site = BeastmasterLockSite(i);
+    WriteValue(out, "beastmaster_lock_contentions_total", "lock",
+               GetLockSiteName(site), GetLockStats(site).contentions.load());
+  }
+  WriteHeader(out, "beastmaster_lock_wait_seconds_total", "counter",
+              "Time spent waiting for locks, by lock.");
+  for (uint32 i = 0; i < MAX_LOCK_SITES; ++i) {
+    auto site = BeastmasterLockSite(i);
+    WriteValue(out, "beastmaster_lock_wait_seconds_total", "lock",
+               GetLockSiteName(site),
+               GetLockStats(site).waitNanoseconds.load() / 1e9);
+  }
+}
+
+// Timings since startup as a summary, while instrumentation is on.
+void WriteDurations(std::ostream &out) {
+  if (!BeastmasterMetrics::IsEnabled())
+    return;
+
+  WriteHeader(out, "beastmaster_operation_duration_seconds", "summary",
+              "Latency of the beastmaster handlers and database round "
+              "trips.");
+  for (uint32 i = 0; i < MAX_METRICS; ++i) {
+    auto metric = BeastmasterMetric(i);
+    BeastmasterMetrics::Summary summary =
+        BeastmasterMetrics::Collect(metric, false);
+    std::string label =
+        std::string("operation=\"") + BeastmasterMetrics::GetName(metric) +
+        '"';
+    std::pair<char const *, uint64> const quantiles[] = {
+        {"0.5", summary.p50}, {"0.99", summary.p99}, {"0.999", summary.p999}};
+    for (auto const &[quantile, value] : quantiles)
+      out << "beastmaster_operation_duration_seconds{" << label
+          << ",quantile=\"" << quantile << "\"} " << value / 1e9 << '\n';
+    out << "beastmaster_operation_duration_seconds_sum{" << label << "} "
+        << summary.totalNanoseconds / 1e9 << '\n'
+        << "beastmaster_operation_duration_seconds_count{" << label << "} "
+        << summary.count << '\n';
+  }
+}
+} // namespace
+
+void BeastmasterExporter::Configure(std::string const &path,
+                                    uint32 intervalMs) {
+  if (_thread.joinable() && path == _path && intervalMs == _intervalMs)
+    return;
+
+  Stop();
+  _path = path;
+  _intervalMs = intervalMs;
+  if (path.empty())
+    return;
+
+  _stopping = false;
+  _thread = std::thread(&BeastmasterExporter::Run, this, path,
+                        std::chrono::milliseconds(intervalMs));
+  LOG_INFO("module", "Beastmaster: Exporting metrics to {} every {} ms.",
+           path, intervalMs);
+}
+
+void BeastmasterExporter::Stop() {
+  if (!_thread.joinable())
+    return;
+  {
+    std::lock_guard<std::mutex> lock(_lock);
+    _stopping = true;
+  }
+  _wake.notify_all();
+  _thread.join();
+}
+
+void BeastmasterExporter::Run(std::string path,
+                              std::chrono::milliseconds interval) {
+  bool failed = false;
+  std::unique_lock<std::mutex> lock(_lock);
+  while (!_stopping) {
+    lock.unlock();
+    bool written = WriteFile(path, Render());
+    if (!written && !failed)
+      LOG_WARN("module", "Beastmaster: Could not write metrics to {}.", path);
+    failed = !written; // Warn once per run of failures
+    lock.lock();
+    _wake.wait_for(lock, interval, [this]() { return _stopping; });
+  }
+}
+
+/*static*/ std::string BeastmasterExporter::Render() {
+  std::ostringstream out;
+  WriteAdoptions(out);
+  WriteTrackedPetsCache(out);
+  WriteDatabase(out);
+  WriteCatalog(out);
+  WriteLocks(out);
+  WriteDurations(out);
+  return out.str();
+}
+
+/*static*/ bool BeastmasterExporter::WriteFile(std::string const &path,
+                                               std::string const &text) {
+  // The collector only reads *.prom files, so it skips the temporary one.
+  std::string temp = path + ".tmp";
+  std::error_code ec;
+  {
+    std::ofstream file(temp, std::ios::trunc);
+    file << text;
+    if (!file.good()) {
+      file.close();
+      std::filesystem::remove(temp, ec);
+      return false;
+    }
+  }
+
+  std::filesystem::rename(temp, path, ec);
+  if (ec) {
+    std::filesystem::remove(temp, ec);
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,64 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_EXPORTER_H_
+#define _BEASTMASTER_EXPORTER_H_
+
+#include "Common.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * BeastmasterExporter
+ * Writes the module's counters and gauges in the Prometheus text format,
+ * for node_exporter's textfile collector. Runs on its own thread and only
+ * reads atomics and published snapshots, taking none of the module's locks,
+ * so the world and map updates never wait on it. Each export goes to a
+ * temporary file that is renamed over the target, so a scrape never sees a
+ * partial file.
+ */
+class BeastmasterExporter {
+public:
+  ~BeastmasterExporter() { Stop(); }
+
+  // Exports to the path every intervalMs; an empty path stops exporting.
+  // Unchanged settings leave a running exporter alone.
+  void Configure(std::string const &path, uint32 intervalMs);
+
+  // Joins the export thread after the export in progress, if any.
+  void Stop();
+
+  // The current metrics in the Prometheus text format.
+  static std::string Render();
+
+private:
+  void Run(std::string path, std::chrono::milliseconds interval);
+  static bool WriteFile(std::string const &path, std::string const &text);
+
+  std::thread _thread;
+  std::mutex _lock;
+  std::condition_variable _wake;
+  bool _stopping = false;
+  std::string _path;
+  uint32 _intervalMs = 0;
+};
+
+#endif // _BEASTMASTER_EXPORTER_H_
@@ -0,0 +1,262 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterHappinessKeeper.h"
+#include "Log.h"
+#include "Map.h"
+#include "ObjectAccessor.h"
+#include "Pet.h"
+#include "Player.h"
+#include <algorithm>
+#include <chrono>
+
+void BeastmasterHappinessKeeper::Wheel::Resize(uint32 slotCount) {
+  std::vector<uint64> guids;
+  guids.reserve(members.size());
+  for (auto const &member : members)
+    guids.push_back(member.first);
+
+  slots.assign(slotCount, {});
+  members.clear();
+  cursor = 0;
+  elapsed = 0;
+
+  // Spread existing members evenly so a reload does not bunch them up.
+  uint32 slot = 0;
+  for (uint64 guid : guids) {
+    slots[slot].push_back(guid);
+    members[guid] = slot;
+    slot = (slot + 1) % slotCount;
+  }
+}
+
+bool BeastmasterHappinessKeeper::Wheel::Insert(uint64 guid) {
+  if (members.count(guid))
+    return false;
+
+  // Queue behind the cursor so the first visit is one full turn away.
+  uint32 slot = (cursor + slots.size() - 1) % slots.size();
+  slots[slot].push_back(guid);
+  members[guid] = slot;
+  return true;
+}
+
+/*static*/ uint64 BeastmasterHappinessKeeper::MakeMapKey(Map const *map) {
+  return (uint64(map->GetId()) << 32) | map->GetInstanceId();
+}
+
+uint32 BeastmasterHappinessKeeper::GetSlotCount() const {
+  uint32 interval = _intervalMs.load(std::memory_order_relaxed);
+  return std::max<uint32>(1, (interval + WHEEL_TICK_MS - 1) / WHEEL_TICK_MS);
+}
+
+std::shared_ptr<BeastmasterHappinessKeeper::Wheel>
+BeastmasterHappinessKeeper::FindWheel(uint64 mapKey) const {
+  std::shared_lock<std::shared_mutex> lock(_wheelsLock);
+  auto it = _wheels.find(mapKey);
+  return it != _wheels.end() ? it->second : nullptr;
+}
+
+void BeastmasterHappinessKeeper::Configure(bool enabled, uint32 intervalMs,
+                                           uint32 threshold) {
+  _intervalMs.store(std::max<uint32>(intervalMs, WHEEL_TICK_MS),
+                    std::memory_order_relaxed);
+  _threshold.store(threshold, std::memory_order_relaxed);
+  _enabled.store(enabled, std::memory_order_relaxed);
+
+  std::unique_lock<std::shared_mutex> lock(_wheelsLock);
+  if (!enabled) {
+    _wheels.clear();
+    _playerMaps.clear();
+    _trackedPlayers.store(0, std::memory_order_relaxed);
+    return;
+  }
+
+  uint32 slotCount = GetSlotCount();
+  for (auto &pair : _wheels) {
+    std::lock_guard<std::mutex> wheelLock(pair.second->lock);
+    if (pair.second->slots.size() != slotCount)
+      pair.second->Resize(slotCount);
+  }
+}
+
+void BeastmasterHappinessKeeper::Register(Player *player) {
+  if (!_enabled.load(std::memory_order_relaxed) || !player->FindMap())
+    return;
+
+  uint64 guid = player->GetGUID().GetRawValue();
+  uint64 mapKey = MakeMapKey(player->GetMap());
+
+  std::unique_lock<std::shared_mutex> lock(_wheelsLock);
+
+  // A player that changed maps is moved over to the new wheel.
+  auto previous = _playerMaps.find(guid);
+  if (previous != _playerMaps.end() && previous->second != mapKey) {
+    auto oldWheel = _wheels.find(previous->second);
+    if (oldWheel != _wheels.end()) {
+      std::lock_guard<std::mutex> wheelLock(oldWheel->second->lock);
+      if (oldWheel->second->members.erase(guid))
+        --_trackedPlayers;
+    }
+  }
+  _playerMaps[guid] = mapKey;
+
+  std::shared_ptr<Wheel> &wheel = _wheels[mapKey];
+  if (!wheel) {
+    wheel = std::make_shared<Wheel>();
+    wheel->slots.resize(GetSlotCount());
+  }
+
+  std::lock_guard<std::mutex> wheelLock(wheel->lock);
+  if (wheel->Insert(guid))
+    ++_trackedPlayers;
+}
+
+void BeastmasterHappinessKeeper::Unregister(Player *player) {
+  uint64 guid = player->GetGUID().GetRawValue();
+
+  std::unique_lock<std::shared_mutex> lock(_wheelsLock);
+  auto it = _playerMaps.find(guid);
+  if (it == _playerMaps.end())
+    return;
+
+  auto wheel = _wheels.find(it->second);
+  if (wheel != _wheels.end()) {
+    // The stale slot entry is skipped when the cursor reaches it.
+    std::lock_guard<std::mutex> wheelLock(wheel->second->lock);
+    if (wheel->second->members.erase(guid))
+      --_trackedPlayers;
+  }
+  _playerMaps.erase(it);
+}
+
+void BeastmasterHappinessKeeper::Update(Map *map, uint32 diff) {
+  if (!_enabled.load(std::memory_order_relaxed))
+    return;
+
+  uint64 mapKey = MakeMapKey(map);
+  std::shared_ptr<Wheel> wheel = FindWheel(mapKey);
+  if (!wheel)
+    return;
+
+  uint32 threshold = _threshold.load(std::memory_order_relaxed);
+  std::vector<uint64> dropped;
+
+  std::unique_lock<std::mutex> wheelLock(wheel->lock);
+  if (wheel->members.empty())
+    return;
+
+  wheel->elapsed += diff;
+  while (wheel->elapsed >= WHEEL_TICK_MS) {
+    wheel->elapsed -= WHEEL_TICK_MS;
+    uint32 slot = wheel->cursor;
+    wheel->cursor = (wheel->cursor + 1) % wheel->slots.size();
+
+    if (wheel->slots[slot].empty())
+      continue;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint64> due;
+    due.swap(wheel->slots[slot]);
+    // A player unregistered and re-queued into the same slot shows up twice.
+    std::sort(due.begin(), due.end());
+    due.erase(std::unique(due.begin(), due.end()), due.end());
+    uint32 visited = 0;
+
+    for (uint64 guid : due) {
+      auto member = wheel->members.find(guid);
+      if (member == wheel->members.end() || member->second != slot)
+        continue; // Unregistered or re-queued elsewhere.
+
+      ++visited;
+      Player *player = ObjectAccessor::GetPlayer(map, ObjectGuid(guid));
+      Pet *pet = player ? player->GetPet() : nullptr;
+      if (!pet || pet->getPetType() != HUNTER_PET) {
+        wheel->members.erase(member);
+        dropped.push_back(guid);
+        --_trackedPlayers;
+        continue;
+      }
+
+      if (pet->GetPower(POWER_HAPPINESS) < threshold) {
+        pet->SetPower(POWER_HAPPINESS, pet->GetMaxPower(POWER_HAPPINESS));
+        ++_toppedUp;
+      }
+
+      // Same slot again means one full turn of the wheel from now.
+      wheel->slots[slot].push_back(guid);
+    }
+
+    uint32 micros =
+        uint32(std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - start)
+                   .count());
+    ++_sweeps;
+    _lastSweepPlayers.store(visited, std::memory_order_relaxed);
+    _lastSweepMicros.store(micros, std::memory_order_relaxed);
+    if (micros > _maxSweepMicros.load(std::memory_order_relaxed))
+      _maxSweepMicros.store(micros, std::memory_order_relaxed);
+
+    LOG_DEBUG("module",
+              "Beastmaster: Happiness sweep on map {} visited {} players in "
+              "{} us ({} tracked in total).",
+              map->GetId(), visited, micros, _trackedPlayers.load());
+  }
+  wheelLock.unlock();
+
+  if (dropped.empty())
+    return;
+
+  std::unique_lock<std::shared_mutex> lock(_wheelsLock);
+  for (uint64 guid : dropped) {
+    auto it = _playerMaps.find(guid);
+    if (it != _playerMaps.end() && it->second == mapKey)
+      _playerMaps.erase(it);
+  }
+}
+
+void BeastmasterHappinessKeeper::RemoveMap(Map *map) {
+  uint64 mapKey = MakeMapKey(map);
+
+  std::unique_lock<std::shared_mutex> lock(_wheelsLock);
+  auto it = _wheels.find(mapKey);
+  if (it == _wheels.end())
+    return;
+
+  {
+    std::lock_guard<std::mutex> wheelLock(it->second->lock);
+    for (auto const &member : it->second->members) {
+      auto playerMap = _playerMaps.find(member.first);
+      if (playerMap != _playerMaps.end() && playerMap->second == mapKey)
+        _playerMaps.erase(playerMap);
+    }
+    _trackedPlayers -= it->second->members.size();
+  }
+  _wheels.erase(it);
+}
+
+BeastmasterHappinessKeeper::Stats BeastmasterHappinessKeeper::GetStats() const {
+  Stats stats;
+  stats.trackedPlayers = _trackedPlayers.load(std::memory_order_relaxed);
+  stats.lastSweepPlayers = _lastSweepPlayers.load(std::memory_order_relaxed);
+  stats.lastSweepMicros = _lastSweepMicros.load(std::memory_order_relaxed);
+  stats.maxSweepMicros = _maxSweepMicros.load(std::memory_order_relaxed);
+  stats.sweeps = _sweeps.load(std::memory_order_relaxed);
+  stats.toppedUp = _toppedUp.load(std::memory_order_relaxed);
+  return stats;
+}
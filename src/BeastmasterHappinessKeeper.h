@@ -0,0 +1,112 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_HAPPINESS_KEEPER_H_
+#define _BEASTMASTER_HAPPINESS_KEEPER_H_
+
+#include "Common.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+class Map;
+class Player;
+
+/**
+ * BeastmasterHappinessKeeper
+ * Keeps hunter pets happy without touching every player on every tick.
+ *
+ * Each map owns a timer wheel holding only the players that currently have a
+ * hunter pet out. A player is visited once per configured interval, and the
+ * pet's happiness is only written when it dropped below the threshold.
+ * Players are registered when a pet is initialised, or when a reload turns
+ * the keeper on with the pet already out, and removed on logout;
+ * dismissed pets and map changes are dropped lazily on the next visit.
+ */
+class BeastmasterHappinessKeeper {
+public:
+  struct Stats {
+    uint32 trackedPlayers = 0;
+    uint32 lastSweepPlayers = 0;
+    uint32 lastSweepMicros = 0;
+    uint32 maxSweepMicros = 0;
+    uint64 sweeps = 0;
+    uint64 toppedUp = 0;
+  };
+
+  /**
+   * Applies interval (ms) and threshold (happiness value) settings.
+   * Existing wheels are redistributed over the new slot count.
+   */
+  void Configure(bool enabled, uint32 intervalMs, uint32 threshold);
+
+  // Registers the player on the wheel of the map they are currently on.
+  void Register(Player *player);
+
+  // Removes the player from whatever wheel they are on.
+  void Unregister(Player *player);
+
+  // Advances the wheel of the given map and tops up due pets.
+  void Update(Map *map, uint32 diff);
+
+  // Forgets the wheel of a map that is being destroyed.
+  void RemoveMap(Map *map);
+
+  Stats GetStats() const;
+
+private:
+  // Slot resolution of the wheel; the interval is rounded up to a multiple.
+  static constexpr uint32 WHEEL_TICK_MS = 250;
+
+  struct Wheel {
+    std::mutex lock;
+    std::vector<std::vector<uint64>> slots;
+    // Player GUID -> slot the player is currently queued in.
+    std::unordered_map<uint64, uint32> members;
+    uint32 cursor = 0;
+    uint32 elapsed = 0;
+
+    void Resize(uint32 slotCount);
+    bool Insert(uint64 guid);
+  };
+
+  static uint64 MakeMapKey(Map const *map);
+  uint32 GetSlotCount() const;
+  std::shared_ptr<Wheel> FindWheel(uint64 mapKey) const;
+
+  std::atomic<bool> _enabled{false};
+  std::atomic<uint32> _intervalMs{5000};
+  std::atomic<uint32> _threshold{0};
+
+  mutable std::shared_mutex _wheelsLock;
+  std::unordered_map<uint64, std::shared_ptr<Wheel>> _wheels;
+  // Player GUID -> map key, so logout can find the right wheel.
+  std::unordered_map<uint64, uint64> _playerMaps;
+
+  std::atomic<uint32> _trackedPlayers{0};
+  std::atomic<uint32> _lastSweepPlayers{0};
+  std::atomic<uint32> _lastSweepMicros{0};
+  std::atomic<uint32> _maxSweepMicros{0};
+  std::atomic<uint64> _sweeps{0};
+  std::atomic<uint64> _toppedUp{0};
+};
+
+#endif // _BEASTMASTER_HAPPINESS_KEEPER_H_
@@ -0,0 +1,139 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterJournal.h"
+#include "BeastmasterDatabase.h"
+#include "BeastmasterMetrics.h"
+#include "DatabaseEnv.h"
+#include "GameTime.h"
+#include "Log.h"
+#include <chrono>
+#include <thread>
+
+void BeastmasterJournal::Insert(uint32 owner, uint32 entry,
+                                std::string const &name) {
+  _queue.Insert(owner, entry, name, GameTime::GetGameTime().count());
+}
+
+void BeastmasterJournal::Update(uint32 diff, uint32 flushInterval) {
+  {
+    std::lock_guard<std::mutex> lock(_commitsLock);
+    _commits.ProcessReadyCallbacks();
+    _flushTimer += diff;
+    if (_flushTimer < flushInterval &&
+        _queue.GetPendingCount() < BeastmasterJournalQueue::MAX_PENDING)
+      return;
+    _flushTimer = 0;
+  }
+
+  Flush();
+}
+
+void BeastmasterJournal::Flush(bool direct /*= false*/) {
+  if (!direct) {
+    _queue.Flush([this](auto const &batch) { CommitAsync(batch); });
+    return;
+  }
+
+  // Only at shutdown, when nothing else polls the callbacks: wait for the
+  // outstanding transaction, then commit the rest ourselves.
+  for (;;) {
+    {
+      std::lock_guard<std::mutex> lock(_commitsLock);
+      _commits.ProcessReadyCallbacks();
+    }
+    if (_queue.Flush([this](auto const &batch) { CommitDirect(batch); }))
+      return;
+    if (!_queue.IsCommitting() && !_queue.GetPendingCount())
+      return;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+void BeastmasterJournal::FlushOwner(uint32 owner) {
+  _queue.FlushOwner(owner, [this](auto const &batch) { CommitAsync(batch); });
+}
+
+/*static*/ CharacterDatabaseTransaction BeastmasterJournal::BuildTransaction(
+    BeastmasterJournalQueue::Batch const &batch) {
+  CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+  for (PendingOp const &op : batch) {
+    switch (op.type) {
+    case BeastmasterJournalQueue::OP_INSERT:
+    case BeastmasterJournalQueue::OP_REPLACE: {
+      BeastmasterStatement stmt(op.type == BeastmasterJournalQueue::OP_INSERT
+                                    ? BM_CHAR_INS_TAMED_PET
+                                    : BM_CHAR_REP_TAMED_PET);
+      stmt.SetData(0, op.owner);
+      stmt.SetData(1, op.entry);
+      stmt.SetData(2, op.name);
+      // The date the overlay pages by, not the commit time.
+      stmt.SetData(3, uint32(op.date));
+      BeastmasterDB::Append(trans, stmt);
+      break;
+    }
+    case BeastmasterJournalQueue::OP_RENAME: {
+      BeastmasterStatement stmt(BM_CHAR_UPD_TAMED_PET_NAME);
+      stmt.SetData(0, op.name);
+      stmt.SetData(1, op.owner);
+      stmt.SetData(2, op.entry);
+      BeastmasterDB::Append(trans, stmt);
+      break;
+    }
+    case BeastmasterJournalQueue::OP_DELETE: {
+      BeastmasterStatement stmt(BM_CHAR_DEL_TAMED_PET);
+      stmt.SetData(0, op.owner);
+      stmt.SetData(1, op.entry);
+      BeastmasterDB::Append(trans, stmt);
+      break;
+    }
+    }
+  }
+  return trans;
+}
+
+void BeastmasterJournal::CommitAsync(
+    BeastmasterJournalQueue::Batch const &batch) {
+  LOG_DEBUG("module", "Beastmaster: Flushing {} tamed pet write(s).",
+            batch.size());
+
+  CharacterDatabaseTransaction trans = BuildTransaction(batch);
+
+  // A failed commit is released too: its rows will not show up later either.
+  std::lock_guard<std::mutex> lock(_commitsLock);
+  _commits.AddCallback(
+      CharacterDatabase.AsyncCommitTransaction(trans).AfterComplete(
+          [this, start = BeastmasterMetrics::Start()](bool /*success*/) {
+            BeastmasterMetrics::RecordSince(METRIC_DB_JOURNAL_COMMIT, start);
+            _queue.Committed();
+          }));
+}
+
+void BeastmasterJournal::CommitDirect(
+    BeastmasterJournalQueue::Batch const &batch) {
+  LOG_DEBUG("module", "Beastmaster: Flushing {} tamed pet write(s) before "
+                      "shutdown.",
+            batch.size());
+
+  CharacterDatabaseTransaction trans = BuildTransaction(batch);
+  {
+    BeastmasterTimer timer(METRIC_DB_JOURNAL_COMMIT);
+    CharacterDatabase.DirectCommitTransaction(trans);
+  }
+  _queue.Committed();
+}
@@ -0,0 +1,95 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_JOURNAL_H_
+#define _BEASTMASTER_JOURNAL_H_
+
+#include "AsyncCallbackProcessor.h"
+#include "BeastmasterJournalQueue.h"
+#include "Common.h"
+#include "DatabaseEnv.h"
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * BeastmasterJournal
+ * Write-behind queue for beastmaster_tamed_pets.
+ *
+ * Callers update their in-memory state right away and record the write
+ * here. The writes are coalesced by BeastmasterJournalQueue and written out
+ * in one transaction per flush: every FlushInterval from the world update,
+ * for one owner at logout, and synchronously at shutdown.
+ *
+ * Only one transaction is queued at a time; operations recorded meanwhile
+ * wait for the next flush after it commits. Two transactions touching the
+ * same pet can therefore never run out of order, whatever the number of
+ * database worker threads.
+ *
+ * Thread-safe.
+ */
+class BeastmasterJournal {
+public:
+  using OpType = BeastmasterJournalQueue::OpType;
+  using PendingOp = BeastmasterJournalQueue::PendingOp;
+
+  void Insert(uint32 owner, uint32 entry, std::string const &name);
+  void Rename(uint32 owner, uint32 entry, std::string const &name) {
+    _queue.Rename(owner, entry, name);
+  }
+  void Delete(uint32 owner, uint32 entry) { _queue.Delete(owner, entry); }
+
+  // Counts down the flush interval; flushes early if the queue gets large.
+  void Update(uint32 diff, uint32 flushInterval);
+
+  // Writes every pending operation in one transaction, unless the previous
+  // one has not committed yet. A direct flush first waits for that one and
+  // then blocks until its own is committed, for use at shutdown.
+  void Flush(bool direct = false);
+
+  // Writes the pending operations of one owner, e.g. at logout. Left for
+  // the next flush while a transaction is outstanding.
+  void FlushOwner(uint32 owner);
+
+  // See BeastmasterJournalQueue::GetPending().
+  std::vector<PendingOp> GetPending(uint32 owner) const {
+    return _queue.GetPending(owner);
+  }
+
+  std::size_t GetPendingCount() const { return _queue.GetPendingCount(); }
+
+private:
+  static CharacterDatabaseTransaction
+  BuildTransaction(BeastmasterJournalQueue::Batch const &batch);
+
+  // Queues the batch as an asynchronous transaction.
+  void CommitAsync(BeastmasterJournalQueue::Batch const &batch);
+
+  // Commits the batch before returning.
+  void CommitDirect(BeastmasterJournalQueue::Batch const &batch);
+
+  BeastmasterJournalQueue _queue;
+  // Guards the members below. Taken before the queue lock, never under it.
+  std::mutex _commitsLock;
+  uint32 _flushTimer = 0;
+  // Completion of the queued commit, polled by Update() to time it and
+  // release the batch.
+  AsyncCallbackProcessor<TransactionCallback> _commits;
+};
+
+#endif // _BEASTMASTER_JOURNAL_H_
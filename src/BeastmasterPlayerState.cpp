@@ -0,0 +1,70 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterPlayerState.h"
+#include "BeastmasterCatalog.h"
+#include <algorithm>
+
+void BeastmasterPlayerState::SetTamedEntries(std::vector<uint32> entries) {
+  std::sort(entries.begin(), entries.end());
+  entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+  _tamedEntries = std::move(entries);
+  _tamedLoaded = true;
+  _tamedRowsValid = false;
+}
+
+bool BeastmasterPlayerState::HasTamed(uint32 entry) const {
+  return std::binary_search(_tamedEntries.begin(), _tamedEntries.end(), entry);
+}
+
+void BeastmasterPlayerState::AddTamed(uint32 entry) {
+  auto it = std::lower_bound(_tamedEntries.begin(), _tamedEntries.end(), entry);
+  if (it != _tamedEntries.end() && *it == entry)
+    return;
+  _tamedEntries.insert(it, entry);
+  _tamedRowsValid = false;
+}
+
+void BeastmasterPlayerState::RemoveTamed(uint32 entry) {
+  auto it = std::lower_bound(_tamedEntries.begin(), _tamedEntries.end(), entry);
+  if (it == _tamedEntries.end() || *it != entry)
+    return;
+  _tamedEntries.erase(it);
+  _tamedRowsValid = false;
+}
+
+bool BeastmasterPlayerState::IsTamedRow(BeastmasterCatalog const &catalog,
+                                        uint32 row) {
+  if (!_tamedRowsValid || _tamedRowsVersion != catalog.GetVersion())
+    RebuildTamedRows(catalog);
+  if (row / 64 >= _tamedRows.size())
+    return false;
+  return (_tamedRows[row / 64] >> (row % 64)) & 1;
+}
+
+void BeastmasterPlayerState::RebuildTamedRows(
+    BeastmasterCatalog const &catalog) {
+  _tamedRows.assign((catalog.GetSize() + 63) / 64, 0);
+  for (uint32 entry : _tamedEntries) {
+    uint32 row = catalog.FindRow(entry);
+    if (row != BeastmasterCatalog::NOT_FOUND)
+      _tamedRows[row / 64] |= uint64(1) << (row % 64);
+  }
+  _tamedRowsVersion = catalog.GetVersion();
+  _tamedRowsValid = true;
+}
@@ -0,0 +1,111 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_PLAYER_STATE_H_
+#define _BEASTMASTER_PLAYER_STATE_H_
+
+#include "BeastmasterTrackedPages.h"
+#include "Common.h"
+#include "DataMap.h"
+#include <array>
+#include <vector>
+
+class BeastmasterCatalog;
+
+/**
+ * BeastmasterPlayerState
+ * Per-player beastmaster data, kept in Player::CustomData from login until
+ * logout.
+ *
+ * Holds the entries the player has tracked, prefetched asynchronously at
+ * login, so catalog pages and the max tracked pets check never hit the
+ * database. The "already tamed" overlay is a bitset over catalog rows that
+ * is rebuilt lazily whenever a new catalog snapshot is published.
+ *
+ * Also holds the gossip session: which pet, with its name, each item of the
+ * tracked pets page on screen stands for, and the pet a pending .petname
+ * rename applies to. Both live in fixed slots, so menu clicks neither
+ * allocate nor look up CustomData by name.
+ */
+class BeastmasterPlayerState : public DataMap::Base {
+public:
+  static constexpr char const *KEY = "BeastmasterPlayerState";
+
+  // Replaces the tracked set with the rows returned by the login query.
+  void SetTamedEntries(std::vector<uint32> entries);
+
+  bool IsTamedLoaded() const { return _tamedLoaded; }
+  uint32 GetTamedCount() const { return uint32(_tamedEntries.size()); }
+
+  bool HasTamed(uint32 entry) const;
+  void AddTamed(uint32 entry);
+  void RemoveTamed(uint32 entry);
+
+  // True if the pet on the given catalog row is already tracked.
+  bool IsTamedRow(BeastmasterCatalog const &catalog, uint32 row);
+
+  // Incremented on every login so stale async results can be told apart.
+  uint32 loadToken = 0;
+
+  // Incremented on every gossip interaction; async menu results carrying an
+  // older token belong to a menu the player already left.
+  uint32 menuToken = 0;
+
+  // Tracked pets page that was last shown, to page on from.
+  BeastmasterTrackedPageInfo trackedPage;
+
+  // Forgets the tracked pets page, once another menu replaces it or the
+  // menu is closed.
+  void ResetMenu() { _menuEntryCount = 0; }
+
+  // Appends the pet behind the next item index of the tracked pets page.
+  void AddMenuEntry(BeastmasterTrackedPet const &pet) {
+    if (_menuEntryCount < _menuEntries.size())
+      _menuEntries[_menuEntryCount++] = pet;
+  }
+
+  // Pet behind an item index of the tracked pets page; null if there is none.
+  BeastmasterTrackedPet const *GetMenuPet(uint32 index) const {
+    return index < _menuEntryCount ? &_menuEntries[index] : nullptr;
+  }
+
+  // Entry behind an item index of the tracked pets page; 0 if there is none.
+  uint32 GetMenuEntry(uint32 index) const {
+    return index < _menuEntryCount ? _menuEntries[index].entry : 0;
+  }
+
+  // Entry of the tracked pet awaiting .petname rename; 0 if none.
+  uint32 GetPendingRename() const { return _renameEntry; }
+  void SetPendingRename(uint32 entry) { _renameEntry = entry; }
+  void ClearPendingRename() { _renameEntry = 0; }
+
+private:
+  void RebuildTamedRows(BeastmasterCatalog const &catalog);
+
+  bool _tamedLoaded = false;
+  std::vector<uint32> _tamedEntries; // sorted
+  std::vector<uint64> _tamedRows;    // bit per catalog row
+  uint32 _tamedRowsVersion = 0;      // catalog version _tamedRows matches
+  bool _tamedRowsValid = false;
+
+  std::array<BeastmasterTrackedPet, PET_TRACKED_PAGE_SIZE> _menuEntries{};
+  uint32 _menuEntryCount = 0;
+  uint32 _renameEntry = 0;
+};
+
+#endif // _BEASTMASTER_PLAYER_STATE_H_
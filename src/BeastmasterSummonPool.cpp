@@ -0,0 +1,89 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterSummonPool.h"
+#include "Creature.h"
+#include "Map.h"
+#include "ObjectAccessor.h"
+#include "Player.h"
+#include <algorithm>
+
+/*static*/ uint64 BeastmasterSummonPool::GetMapKey(Map const *map) {
+  return (uint64(map->GetId()) << 32) | map->GetInstanceId();
+}
+
+std::vector<BeastmasterSummonPool::Summon> &
+BeastmasterSummonPool::Prune(Player *player) {
+  auto isGone = [player](Summon const &summon) {
+    Creature *creature = ObjectAccessor::GetCreature(*player, summon.guid);
+    return !creature || !creature->IsAlive();
+  };
+
+  auto &summons = _summons[GetMapKey(player->GetMap())];
+  summons.erase(std::remove_if(summons.begin(), summons.end(), isGone),
+                summons.end());
+  return summons;
+}
+
+Creature *BeastmasterSummonPool::FindNearby(Player *player, float range) {
+  std::lock_guard<BeastmasterMutex> lock(_lock);
+  for (Summon const &summon : Prune(player)) {
+    Creature *creature = ObjectAccessor::GetCreature(*player, summon.guid);
+    if (creature->IsWithinDistInMap(player, range))
+      return creature;
+  }
+  return nullptr;
+}
+
+BeastmasterSummonPool::Result
+BeastmasterSummonPool::CanSummon(Player *player, uint32 maxPerMap,
+                                 uint32 maxPerZone) {
+  std::lock_guard<BeastmasterMutex> lock(_lock);
+  auto const &summons = Prune(player);
+  if (maxPerMap && summons.size() >= maxPerMap)
+    return SUMMON_MAP_FULL;
+
+  uint32 zoneId = player->GetZoneId();
+  if (maxPerZone &&
+      std::count_if(summons.begin(), summons.end(),
+                    [zoneId](Summon const &summon) {
+                      return summon.zoneId == zoneId;
+                    }) >= maxPerZone)
+    return SUMMON_ZONE_FULL;
+
+  return SUMMON_ALLOWED;
+}
+
+void BeastmasterSummonPool::Add(Player *player, Creature *creature) {
+  std::lock_guard<BeastmasterMutex> lock(_lock);
+  _summons[GetMapKey(player->GetMap())].push_back(
+      {creature->GetGUID(), player->GetZoneId()});
+}
+
+void BeastmasterSummonPool::RemoveMap(Map *map) {
+  std::lock_guard<BeastmasterMutex> lock(_lock);
+  _summons.erase(GetMapKey(map));
+}
+
+std::size_t BeastmasterSummonPool::GetSize() const {
+  std::lock_guard<BeastmasterMutex> lock(_lock);
+  std::size_t size = 0;
+  for (auto const &[mapKey, summons] : _summons)
+    size += summons.size();
+  return size;
+}
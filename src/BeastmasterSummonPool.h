@@ -0,0 +1,77 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_SUMMON_POOL_H_
+#define _BEASTMASTER_SUMMON_POOL_H_
+
+#include "BeastmasterMutex.h"
+#include "Common.h"
+#include "ObjectGuid.h"
+#include <unordered_map>
+#include <vector>
+
+class Creature;
+class Map;
+class Player;
+
+/**
+ * BeastmasterSummonPool
+ * The beastmasters summoned with .beastmaster, by map instance, so that a
+ * player near one is pointed to it instead of summoning another, and the
+ * number alive at once can be capped per map and per zone.
+ *
+ * Entries are pruned lazily: whenever a map's list is read, summons that
+ * have despawned free their place. Thread-safe.
+ */
+class BeastmasterSummonPool {
+public:
+  enum Result {
+    SUMMON_ALLOWED,
+    SUMMON_MAP_FULL,
+    SUMMON_ZONE_FULL,
+  };
+
+  // An alive pooled beastmaster within range of the player, if any.
+  Creature *FindNearby(Player *player, float range);
+
+  // Whether the caps (0 = no cap) leave room for another summon.
+  Result CanSummon(Player *player, uint32 maxPerMap, uint32 maxPerZone);
+
+  void Add(Player *player, Creature *creature);
+
+  void RemoveMap(Map *map);
+
+  // Pooled summons on all maps, including not yet pruned ones.
+  std::size_t GetSize() const;
+
+private:
+  struct Summon {
+    ObjectGuid guid;
+    uint32 zoneId;
+  };
+
+  static uint64 GetMapKey(Map const *map);
+
+  // Drops the player's map's despawned summons. Lock held.
+  std::vector<Summon> &Prune(Player *player);
+
+  mutable BeastmasterMutex _lock{LOCK_SITE_SUMMON_POOL};
+  std::unordered_map<uint64, std::vector<Summon>> _summons;
+};
+
+#endif // _BEASTMASTER_SUMMON_POOL_H_
@@ -17,45 +17,52 @@
  */
 
 #include "NpcBeastmaster.h"
+#include "BeastmasterCatalogFile.h"
+#include "BeastmasterDatabase.h"
+#include "BeastmasterGossipMenu.h"
+#include "BeastmasterMetrics.h"
+#include "BeastmasterNameValidator.h"
+#include "BeastmasterPlayerState.h"
+#include "BeastmasterTameRows.h"
 #include "Chat.h"
 #include "Common.h"
-#include "Config.h"
+#include "ObjectAccessor.h"
 #include "Pet.h"
 #include "Player.h"
 #include "ScriptMgr.h"
 #include "ScriptedCreature.h"
 #include "ScriptedGossip.h"
+#include "Timer.h"
 #include "WorldSession.h"
-#include <fstream>
-#include <locale>
-#include <map>
+#include <algorithm>
+#include <chrono>
 #include <mutex>
-#include <regex>
+#include <optional>
+#include <span>
 #include <sstream>
 #include <sys/stat.h>
-#include <unordered_map>
-#include <unordered_set>
+#include <thread>
 #include <vector>
 
-// Helper to get Beastmaster NPC entry from config
-static uint32 GetBeastmasterNpcEntry() {
-  return sConfigMgr->GetOption<uint32>("BeastMaster.NpcEntry", 601026);
+static BeastmasterPlayerState *GetPlayerState(Player *player) {
+  return player->CustomData.Get<BeastmasterPlayerState>(
+      BeastmasterPlayerState::KEY);
 }
 
 namespace BeastmasterDB {
 bool TrackTamedPet(Player *player, uint32 creatureEntry,
                    std::string const &petName) {
-  QueryResult result =
-      CharacterDatabase.Query("SELECT 1 FROM beastmaster_tamed_pets WHERE "
-                              "owner_guid = {} AND entry = {}",
-                              player->GetGUID().GetCounter(), creatureEntry);
-  if (result)
+  BeastmasterPlayerState *state = GetPlayerState(player);
+  if (state && state->IsTamedLoaded() && state->HasTamed(creatureEntry))
     return false; // Already tracked
 
-  CharacterDatabase.Execute("INSERT INTO beastmaster_tamed_pets (owner_guid, "
-                            "entry, name) VALUES ({}, {}, '{}')",
-                            player->GetGUID().GetCounter(), creatureEntry,
-                            petName.c_str());
+  // Without loaded state the insert is written as INSERT IGNORE, which
+  // keeps an existing row just like the lookup it replaces.
+  sNpcBeastMaster->GetJournal().Insert(player->GetGUID().GetCounter(),
+                                       creatureEntry, petName);
+  if (state)
+    state->AddTamed(creatureEntry);
+  sNpcBeastMaster->ClearTrackedPetsCache(player);
   return true;
 }
 } // namespace BeastmasterDB
@@ -64,44 +71,10 @@ namespace {
 std::vector<uint32> HunterSpells = {883,   982,  2641, 6991,
                                     48990, 1002, 1462, 6197};
 
-using PetList = std::vector<PetInfo>;
-
-PetList allPets;
-PetList normalPets;
-PetList exoticPets;
-PetList rarePets;
-PetList rareExoticPets;
-
-std::set<uint32> rarePetEntries;
-std::set<uint32> rareExoticPetEntries;
-
-// Cached config options for performance and consistency.
-struct BeastmasterConfig {
-  bool hunterOnly = true;
-  bool allowExotic = false;
-  bool keepPetHappy = false;
-  uint32 minLevel = 10;
-  uint32 maxLevel = 0;
-  bool hunterBeastMasteryRequired = true;
-  bool trackTamedPets = false;
-  uint32 maxTrackedPets = 20;
-  std::set<uint8> allowedRaces;
-  std::set<uint8> allowedClasses;
-} beastmasterConfig;
-
 enum PetGossip {
   PET_BEASTMASTER_HOWL = 9036,
-  PET_PAGE_SIZE = 13,
-  PET_PAGE_START_PETS = 501,
-  PET_PAGE_START_EXOTIC_PETS = 601,
-  PET_PAGE_START_RARE_PETS = 701,
-  PET_PAGE_START_RARE_EXOTIC_PETS = 801,
-  PET_PAGE_MAX = 901,
-  PET_MAIN_MENU = 50,
-  PET_REMOVE_SKILLS = 80,
   PET_GOSSIP_HELLO = 601026,
-  PET_GOSSIP_BROWSE = 601027,
-  PET_TRACKED_PETS_MENU = 1000
+  PET_GOSSIP_BROWSE = 601027
 };
 
 constexpr auto PET_SPELL_CALL_PET = 883;
@@ -109,234 +82,257 @@ constexpr auto PET_SPELL_TAME_BEAST = 13481;
 constexpr auto PET_SPELL_BEAST_MASTERY = 53270;
 constexpr auto PET_MAX_HAPPINESS = 1048000;
 
-std::unordered_map<uint32, PetInfo> allPetsByEntry;
+// Serializes catalog rebuilds; readers go through the published snapshot.
 std::mutex petsMutex;
 
-std::unordered_map<uint64,
-                   std::vector<std::tuple<uint32, std::string, std::string>>>
-    trackedPetsCache;
-} // namespace
-
-enum BeastmasterEvents { BEASTMASTER_EVENT_EAT = 1 };
-
-enum TrackedPetActions {
-  PET_TRACKED_SUMMON = 2000,
-  PET_TRACKED_RENAME = 3000,
-  PET_TRACKED_DELETE = 4000,
-  PET_TRACKED_PAGE_SIZE = 10
-};
-
-enum { PET_TRACKED_RENAME_PROMPT = 5000 };
-
-static std::unordered_set<std::string> sProfanityList;
-static time_t sProfanityListMTime = 0;
-
-static time_t GetFileMTime(const std::string &path) {
-  struct stat statbuf;
-  if (stat(path.c_str(), &statbuf) == 0)
-    return statbuf.st_mtime;
-  return 0;
+// The catalog rules for the config's rare lists.
+BeastmasterTameRules GetTameRules(BeastmasterConfig const &config) {
+  return {GOSSIP_ICON_VENDOR, GOSSIP_ICON_TRAINER, config.rarePetEntries,
+          config.rareExoticPetEntries};
 }
 
-static std::set<uint8> ParseAllowedRaces(const std::string &csv) {
-  std::set<uint8> result;
-  std::stringstream ss(csv);
-  std::string item;
-  while (std::getline(ss, item, ',')) {
-    try {
-      uint8 race = static_cast<uint8>(std::stoul(item));
-      if (race > 0)
-        result.insert(race);
-    } catch (...) {
-    }
+// Identifies the catalog the database and options would produce, without
+// loading it. Empty if the checksum query fails.
+std::optional<BeastmasterCatalogKey>
+QueryCatalogKey(BeastmasterConfig const &config) {
+  QueryResult result =
+      BeastmasterDB::Query(BeastmasterStatement(BM_WORLD_SEL_TAMES_CHECKSUM));
+  if (!result)
+    return std::nullopt;
+
+  Field *fields = result->Fetch();
+  BeastmasterCatalogKey key;
+  key.rowCount = fields[0].Get<uint64>();
+  key.crcSum = fields[1].Get<uint64>();
+  key.crcXor = fields[2].Get<uint64>();
+
+  // The rare lists decide categories, so they are part of the catalog too.
+  uint64 hash = BeastmasterCatalogFile::Hash({});
+  for (auto const *entries :
+       {&config.rarePetEntries, &config.rareExoticPetEntries}) {
+    for (uint32 entry : *entries)
+      hash = BeastmasterCatalogFile::Hash(
+          std::as_bytes(std::span<uint32 const>(&entry, 1)), hash);
+    uint32 const separator = 0;
+    hash = BeastmasterCatalogFile::Hash(
+        std::as_bytes(std::span<uint32 const>(&separator, 1)), hash);
   }
-  return result;
+  key.optionsHash = hash;
+  return key;
 }
 
-static std::set<uint8> ParseAllowedClasses(const std::string &csv) {
-  std::set<uint8> result;
-  std::stringstream ss(csv);
-  std::string item;
-  while (std::getline(ss, item, ',')) {
-    try {
-      uint8 cls = static_cast<uint8>(std::stoul(item));
-      if (cls > 0)
-        result.insert(cls);
-    } catch (...) {
-    }
-  }
-  return result;
-}
+// Lock stats at the last `.beastmaster stats reset`. Only the in-game
+// output is relative to them; the exported counters stay monotonic.
+std::array<BeastmasterLockStats, MAX_LOCK_SITES> LockStatsBaseline;
+} // namespace
 
-static void LoadProfanityListIfNeeded() {
-  const std::string path = "modules/mod-npc-beastmaster/conf/profanity.txt";
-  time_t mtime = GetFileMTime(path);
-  if (mtime == 0)
-    return;
-  if (mtime == sProfanityListMTime && !sProfanityList.empty())
-    return;
-  sProfanityList.clear();
-  std::ifstream f(path);
-  if (!f.is_open()) {
-    LOG_WARN("module", "Beastmaster: Could not open profanity.txt, skipping "
-                       "profanity filter.");
-    return;
-  }
-  std::string word;
-  while (std::getline(f, word)) {
-    std::transform(word.begin(), word.end(), word.begin(), ::tolower);
-    if (!word.empty())
-      sProfanityList.insert(word);
-  }
-  sProfanityListMTime = mtime;
-  LOG_INFO("module", "Beastmaster: Loaded {} profane words (mtime={})",
-           sProfanityList.size(), long(mtime));
-}
+enum BeastmasterEvents {
+  BEASTMASTER_EVENT_IDLE_CHECK = 1,
+  BEASTMASTER_EVENT_AMBIENT // + index into AmbientBehaviours
+};
+
+// How often an awake beastmaster checks whether anyone can still see it.
+constexpr uint32 BEASTMASTER_IDLE_CHECK_INTERVAL = 10000;
+
+// Something the beastmaster does now and then while players are around.
+struct BeastmasterAmbientBehaviour {
+  uint32 emote;
+  uint32 minDelay; // ms
+  uint32 maxDelay; // ms
+};
+
+// Each row repeats independently at a random delay; add rows for more.
+constexpr BeastmasterAmbientBehaviour AmbientBehaviours[] = {
+    {EMOTE_ONESHOT_EAT_NO_SHEATHE, 30000, 90000},
+};
 
 static bool IsProfane(const std::string &name) {
-  if (!sConfigMgr->GetOption<bool>("BeastMaster.ProfanityFilter", true))
+  if (!sNpcBeastMaster->GetConfig()->profanityFilter)
     return false;
-  LoadProfanityListIfNeeded();
-  std::string lower = name;
-  std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-  for (auto const &bad : sProfanityList)
-    if (lower.find(bad) != std::string::npos)
-      return true;
-  return false;
+  auto filter = sNpcBeastMaster->GetProfanityFilter();
+  return filter && filter->Matches(name);
 }
 
-static bool IsValidPetName(const std::string &name) {
-  if (name.size() < 2 || name.size() > 16)
-    return false;
-  if (std::isspace(name.front()) || std::isspace(name.back()))
-    return false;
-  static const std::regex allowed("^[A-Za-z][A-Za-z \\-']*[A-Za-z]$");
-  return std::regex_match(name, allowed);
+static bool IsValidPetName(std::string_view name) {
+  return BeastmasterNameValidator::IsValid(
+      name, sNpcBeastMaster->GetConfig()->namePolicy);
 }
 
-static std::set<uint32> ParseEntryList(const std::string &csv) {
-  std::set<uint32> result;
-  std::stringstream ss(csv);
-  std::string item;
-  while (std::getline(ss, item, ',')) {
-    try {
-      result.insert(std::stoul(item));
-    } catch (...) {
-    }
-  }
-  return result;
+NpcBeastmaster::NpcBeastmaster() {
+  // Defaults until the first LoadSystem() publishes the real options.
+  configSnapshot.Publish(std::make_shared<BeastmasterConfig const>());
+  catalogSnapshot.Publish(std::make_shared<BeastmasterCatalog const>());
 }
 
-static const PetInfo *FindPetInfo(uint32 entry) {
+/*static*/ NpcBeastmaster *NpcBeastmaster::instance() {
+  static NpcBeastmaster instance;
+  return &instance;
+}
+
+void NpcBeastmaster::LoadSystem(bool /*reload = false*/) {
   std::lock_guard<std::mutex> lock(petsMutex);
-  auto it = allPetsByEntry.find(entry);
-  return it != allPetsByEntry.end() ? &it->second : nullptr;
+
+  BeastmasterDB::LoadStatements();
+
+  bool keptPetsHappy = GetConfig()->keepPetHappy;
+  auto config = BeastmasterConfig::Load(++configVersion);
+  configSnapshot.Publish(config);
+
+  BeastmasterMetrics::SetEnabled(config->metrics);
+  exporter.Configure(config->metricsExportFile,
+                     config->metricsExportInterval);
+
+  happinessKeeper.Configure(config->keepPetHappy, config->keepPetHappyInterval,
+                            PET_MAX_HAPPINESS * config->keepPetHappyThreshold /
+                                100);
+  // Pets register as they are summoned; a reload that turns the keeper on
+  // picks up the ones already out.
+  if (config->keepPetHappy && !keptPetsHappy)
+    for (auto const &[guid, player] : ObjectAccessor::GetPlayers())
+      if (player->IsInWorld() && player->GetPet())
+        happinessKeeper.Register(player);
+  trackedPetsCache.SetBudget(std::size_t(config->trackedPetsCacheBudget) *
+                             1024);
+  // Recompiled off the world thread on the next update: the file or the
+  // normalization option may have changed.
+  profanityReloadRequested = true;
+
+  // The catalog loads alongside the rest of startup. A reload waits for the
+  // previous load so snapshots are published in order.
+  if (catalogLoad.valid())
+    catalogLoad.wait();
+  catalogLoad = std::async(std::launch::async,
+                           [this, config]() { LoadCatalog(*config); });
 }
 
-class BeastmasterBool : public DataMap::Base {
-public:
-  explicit BeastmasterBool(bool v) : value(v) {}
-  bool value;
-};
+void NpcBeastmaster::LoadCatalog(BeastmasterConfig const &config) {
+  uint32 start = getMSTime();
+  std::shared_ptr<BeastmasterCatalog> catalog;
+
+  std::optional<BeastmasterCatalogKey> key;
+  if (!config.catalogFile.empty())
+    key = QueryCatalogKey(config);
+
+  if (key) {
+    std::string error;
+    catalog = BeastmasterCatalogFile::Read(config.catalogFile, *key,
+                                           config.version, error);
+    if (catalog)
+      LOG_INFO("module", "Beastmaster: Mapped {} pets from {}.",
+               catalog->GetSize(), config.catalogFile);
+    else
+      LOG_INFO("module", "Beastmaster: Not using {}: {}.", config.catalogFile,
+               error);
+  }
 
-class BeastmasterUInt32 : public DataMap::Base {
-public:
-  explicit BeastmasterUInt32(uint32 v) : value(v) {}
-  uint32 value;
-};
+  if (!catalog) {
+    catalog = QueryCatalog(config);
+    if (catalog && key &&
+        !BeastmasterCatalogFile::Write(config.catalogFile, *catalog, *key))
+      LOG_WARN("module", "Beastmaster: Could not write {}.",
+               config.catalogFile);
+  }
 
-class BeastmasterPetMap : public DataMap::Base {
-public:
-  std::map<uint32, uint32> map;
-  BeastmasterPetMap(const std::map<uint32, uint32> &m) : map(m) {}
-};
+  if (catalog) {
+    catalog->SetGossipPages(BuildCatalogPages(
+        *catalog, {GOSSIP_ICON_TALK, GOSSIP_ICON_INTERACT_1}));
+    LOG_INFO("module",
+             "Beastmaster: Loaded {} pets into a {} byte catalog (previous "
+             "layout: ~{} bytes) in {} ms.",
+             catalog->GetSize(), catalog->GetMemoryUsage(),
+             catalog->EstimateLegacyMemoryUsage(), GetMSTimeDiffToNow(start));
+    catalogLoadTime.store(GetMSTimeDiffToNow(start),
+                          std::memory_order_relaxed);
+    catalogSnapshot.Publish(std::move(catalog));
+  }
 
-/*static*/ NpcBeastmaster *NpcBeastmaster::instance() {
-  static NpcBeastmaster instance;
-  return &instance;
+  // On failure nothing more is coming; serve whatever catalog is published.
+  catalogReady.store(true, std::memory_order_release);
 }
 
-void NpcBeastmaster::LoadSystem(bool /*reload = false*/) {
-  std::lock_guard<std::mutex> lock(petsMutex);
+std::shared_ptr<BeastmasterCatalog>
+NpcBeastmaster::QueryCatalog(BeastmasterConfig const &config) {
+  uint32 start = getMSTime();
 
-  beastmasterConfig.hunterOnly =
-      sConfigMgr->GetOption<bool>("BeastMaster.HunterOnly", true);
-  beastmasterConfig.allowExotic =
-      sConfigMgr->GetOption<bool>("BeastMaster.AllowExotic", false);
-  beastmasterConfig.keepPetHappy =
-      sConfigMgr->GetOption<bool>("BeastMaster.KeepPetHappy", false);
-  beastmasterConfig.minLevel =
-      sConfigMgr->GetOption<uint32>("BeastMaster.MinLevel", 10);
-  beastmasterConfig.maxLevel =
-      sConfigMgr->GetOption<uint32>("BeastMaster.MaxLevel", 0);
-  beastmasterConfig.hunterBeastMasteryRequired = sConfigMgr->GetOption<uint32>(
-      "BeastMaster.HunterBeastMasteryRequired", true);
-  beastmasterConfig.trackTamedPets =
-      sConfigMgr->GetOption<bool>("BeastMaster.TrackTamedPets", false);
-  beastmasterConfig.maxTrackedPets =
-      sConfigMgr->GetOption<uint32>("BeastMaster.MaxTrackedPets", 20);
-  beastmasterConfig.allowedRaces = ParseAllowedRaces(
-      sConfigMgr->GetOption<std::string>("BeastMaster.AllowedRaces", "0"));
-  beastmasterConfig.allowedClasses = ParseAllowedClasses(
-      sConfigMgr->GetOption<std::string>("BeastMaster.AllowedClasses", "0"));
-
-  rarePetEntries = ParseEntryList(
-      sConfigMgr->GetOption<std::string>("BeastMaster.RarePets", ""));
-  rareExoticPetEntries = ParseEntryList(
-      sConfigMgr->GetOption<std::string>("BeastMaster.RareExoticPets", ""));
-
-  allPets.clear();
-  normalPets.clear();
-  exoticPets.clear();
-  rarePets.clear();
-  rareExoticPets.clear();
-  allPetsByEntry.clear();
-
-  QueryResult result = WorldDatabase.Query(
-      "SELECT entry, name, family, rarity FROM beastmaster_tames");
+  QueryResult result =
+      BeastmasterDB::Query(BeastmasterStatement(BM_WORLD_SEL_TAMES));
   if (!result) {
     LOG_ERROR(
         "module",
         "Beastmaster: Could not load tames from beastmaster_tames table!");
-    return;
+    return nullptr;
   }
 
+  std::vector<BeastmasterTameRow> rows;
+  rows.reserve(result->GetRowCount());
   do {
     Field *fields = result->Fetch();
-    PetInfo info;
-    info.entry = fields[0].Get<uint32>();
-    info.name = fields[1].Get<std::string>();
-    info.family = fields[2].Get<uint32>();
-    info.rarity = fields[3].Get<std::string>();
-
-    static const std::set<uint32> TrainerIconFamilies = {
-        1, 2, 3, 4, 7, 8, 9, 10, 15, 20, 21, 30, 24, 31, 25, 34, 27};
-
-    if (TrainerIconFamilies.count(info.family))
-      info.icon = GOSSIP_ICON_TRAINER;
-    else
-      info.icon = GOSSIP_ICON_VENDOR;
-
-    allPets.push_back(info);
-    allPetsByEntry[info.entry] = info;
-
-    if (rarePetEntries.count(info.entry))
-      rarePets.push_back(info);
-    else if (rareExoticPetEntries.count(info.entry))
-      rareExoticPets.push_back(info);
-    else if (info.rarity == "exotic")
-      exoticPets.push_back(info);
-    else
-      normalPets.push_back(info);
+    BeastmasterTameRow &row = rows.emplace_back();
+    row.entry = fields[0].Get<uint32>();
+    row.name = fields[1].Get<std::string>();
+    row.family = fields[2].Get<uint32>();
+    row.rarity = fields[3].Get<std::string>() == "exotic" ? PET_RARITY_EXOTIC
+                                                           : PET_RARITY_NORMAL;
+    if (!fields[4].IsNull())
+      row.typeFlags = fields[4].Get<uint32>();
   } while (result->NextRow());
+  result.reset();
+  uint32 queryTime = GetMSTimeDiffToNow(start);
+
+  uint32 phaseStart = getMSTime();
+  std::size_t chunks = 0;
+  BeastmasterTameRowStats stats =
+      ValidateTameRows(rows, GetTameRules(config), chunks);
+  uint32 validateTime = GetMSTimeDiffToNow(phaseStart);
+
+  if (stats.missingTemplate || stats.notTameable)
+    LOG_WARN("module",
+             "Beastmaster: Skipped {} tames without a creature_template row "
+             "and {} that are not tameable.",
+             stats.missingTemplate, stats.notTameable);
+  if (stats.rarityCorrected)
+    LOG_WARN("module",
+             "Beastmaster: Corrected the rarity of {} tames to match their "
+             "creature_template exotic flag.",
+             stats.rarityCorrected);
+  if (stats.entryTooLarge)
+    LOG_WARN("module",
+             "Beastmaster: Skipped {} tames with an entry above {}, which the "
+             "adoption menu cannot address.",
+             stats.entryTooLarge, MAX_ADOPT_ENTRY);
+
+  // Built off to the side; readers keep the previous catalog until the swap.
+  phaseStart = getMSTime();
+  auto catalog = BuildCatalog(rows, config.version);
+  uint32 buildTime = GetMSTimeDiffToNow(phaseStart);
+
+  LOG_INFO("module",
+           "Beastmaster: Catalog query took {} ms (query {} ms, validate {} "
+           "ms in {} chunks, build {} ms).",
+           GetMSTimeDiffToNow(start), queryTime, validateTime, chunks,
+           buildTime);
+  return catalog;
 }
 
 void NpcBeastmaster::ShowMainMenu(Player *player, Creature *creature) {
+  BeastmasterTimer timer(METRIC_SHOW_MAIN_MENU);
+  auto config = GetConfig();
+
   // Module enable check
-  if (!sConfigMgr->GetOption<bool>("BeastMaster.Enable", true))
+  if (!config->enabled)
     return;
 
-  if (beastmasterConfig.hunterOnly && player->getClass() != CLASS_HUNTER) {
+  if (!IsCatalogReady()) {
+    if (creature)
+      creature->Whisper("My beasts are still arriving. Come back shortly.",
+                        LANG_UNIVERSAL, player);
+    else
+      ChatHandler(player->GetSession())
+          .PSendSysMessage("My beasts are still arriving. Come back shortly.");
+    return;
+  }
+
+  if (config->hunterOnly && player->getClass() != CLASS_HUNTER) {
     if (creature)
       creature->Whisper("I am sorry, but pets are for hunters only.",
                         LANG_UNIVERSAL, player);
@@ -346,9 +342,7 @@ void NpcBeastmaster::ShowMainMenu(Player *player, Creature *creature) {
     return;
   }
 
-  if (!beastmasterConfig.allowedClasses.empty() &&
-      beastmasterConfig.allowedClasses.find(player->getClass()) ==
-          beastmasterConfig.allowedClasses.end()) {
+  if (!config->IsClassAllowed(player->getClass())) {
     if (creature)
       creature->Whisper("Your class is not allowed to adopt pets.",
                         LANG_UNIVERSAL, player);
@@ -358,9 +352,7 @@ void NpcBeastmaster::ShowMainMenu(Player *player, Creature *creature) {
     return;
   }
 
-  if (!beastmasterConfig.allowedRaces.empty() &&
-      beastmasterConfig.allowedRaces.find(player->getRace()) ==
-          beastmasterConfig.allowedRaces.end()) {
+  if (!config->IsRaceAllowed(player->getRace())) {
     if (creature)
       creature->Whisper("Your race is not allowed to adopt pets.",
                         LANG_UNIVERSAL, player);
@@ -370,11 +362,10 @@ void NpcBeastmaster::ShowMainMenu(Player *player, Creature *creature) {
     return;
   }
 
-  if (player->GetLevel() < beastmasterConfig.minLevel &&
-      beastmasterConfig.minLevel != 0) {
+  if (player->GetLevel() < config->minLevel && config->minLevel != 0) {
     std::string messageExperience = Acore::StringFormat(
         "Sorry {}, but you must reach level {} before adopting a pet.",
-        player->GetName(), beastmasterConfig.minLevel);
+        player->GetName(), config->minLevel);
     if (creature)
       creature->Whisper(messageExperience.c_str(), LANG_UNIVERSAL, player);
     else
@@ -383,11 +374,10 @@ void NpcBeastmaster::ShowMainMenu(Player *player, Creature *creature) {
     return;
   }
 
-  if (beastmasterConfig.maxLevel != 0 &&
-      player->GetLevel() > beastmasterConfig.maxLevel) {
+  if (config->maxLevel != 0 && player->GetLevel() > config->maxLevel) {
     std::string message = Acore::StringFormat(
         "Sorry {}, but you must be level {} or lower to adopt a pet.",
-        player->GetName(), beastmasterConfig.maxLevel);
+        player->GetName(), config->maxLevel);
     if (creature)
       creature->Whisper(message.c_str(), LANG_UNIVERSAL, player);
     else
@@ -395,46 +385,61 @@ void NpcBeastmaster::ShowMainMenu(Player *player, Creature *creature) {
     return;
   }
 
+  if (BeastmasterPlayerState *state = GetPlayerState(player)) {
+    ++state->menuToken;
+    state->ResetMenu();
+  }
+
   ClearGossipMenuFor(player);
 
   AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "Browse Pets",
-                   GOSSIP_SENDER_MAIN, PET_PAGE_START_PETS);
+                   GOSSIP_SENDER_MAIN,
+                   EncodeCatalogPageAction(PET_CATEGORY_NORMAL, 1));
   AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "Browse Rare Pets",
-                   GOSSIP_SENDER_MAIN, PET_PAGE_START_RARE_PETS);
+                   GOSSIP_SENDER_MAIN,
+                   EncodeCatalogPageAction(PET_CATEGORY_RARE, 1));
 
-  if (beastmasterConfig.allowExotic ||
-      player->HasSpell(PET_SPELL_BEAST_MASTERY) ||
+  if (config->allowExotic || player->HasSpell(PET_SPELL_BEAST_MASTERY) ||
       player->HasTalent(PET_SPELL_BEAST_MASTERY, player->GetActiveSpec())) {
     if (player->getClass() != CLASS_HUNTER) {
       AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "Browse Exotic Pets",
-                       GOSSIP_SENDER_MAIN, PET_PAGE_START_EXOTIC_PETS);
+                       GOSSIP_SENDER_MAIN,
+                       EncodeCatalogPageAction(PET_CATEGORY_EXOTIC, 1));
       AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "Browse Rare Exotic Pets",
-                       GOSSIP_SENDER_MAIN, PET_PAGE_START_RARE_EXOTIC_PETS);
-    } else if (!beastmasterConfig.hunterBeastMasteryRequired ||
+                       GOSSIP_SENDER_MAIN,
+                       EncodeCatalogPageAction(PET_CATEGORY_RARE_EXOTIC, 1));
+    } else if (!config->hunterBeastMasteryRequired ||
                player->HasTalent(PET_SPELL_BEAST_MASTERY,
                                  player->GetActiveSpec())) {
       AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "Browse Exotic Pets",
-                       GOSSIP_SENDER_MAIN, PET_PAGE_START_EXOTIC_PETS);
+                       GOSSIP_SENDER_MAIN,
+                       EncodeCatalogPageAction(PET_CATEGORY_EXOTIC, 1));
       AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "Browse Rare Exotic Pets",
-                       GOSSIP_SENDER_MAIN, PET_PAGE_START_RARE_EXOTIC_PETS);
+                       GOSSIP_SENDER_MAIN,
+                       EncodeCatalogPageAction(PET_CATEGORY_RARE_EXOTIC, 1));
     }
   }
 
   if (player->getClass() != CLASS_HUNTER &&
       player->HasSpell(PET_SPELL_CALL_PET))
     AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "Unlearn Hunter Abilities",
-                     GOSSIP_SENDER_MAIN, PET_REMOVE_SKILLS);
+                     GOSSIP_SENDER_MAIN,
+                     EncodeGossipAction(GOSSIP_OPCODE_REMOVE_SKILLS));
 
-  if (beastmasterConfig.trackTamedPets)
+  if (config->trackTamedPets)
     AddGossipItemFor(player, GOSSIP_ICON_CHAT, "My Tamed Pets",
-                     GOSSIP_SENDER_MAIN, PET_TRACKED_PETS_MENU);
+                     GOSSIP_SENDER_MAIN,
+                     EncodeGossipAction(GOSSIP_OPCODE_TRACKED_MENU,
+                                        TRACKED_SEEK_FIRST));
 
   if (player->getClass() == CLASS_HUNTER)
     AddGossipItemFor(player, GOSSIP_ICON_TAXI, "Visit Stable",
-                     GOSSIP_SENDER_MAIN, GOSSIP_OPTION_STABLEPET);
+                     GOSSIP_SENDER_MAIN,
+                     EncodeGossipAction(GOSSIP_OPCODE_STABLE));
 
   AddGossipItemFor(player, GOSSIP_ICON_MONEY_BAG, "Buy Pet Food",
-                   GOSSIP_SENDER_MAIN, GOSSIP_OPTION_VENDOR);
+                   GOSSIP_SENDER_MAIN,
+                   EncodeGossipAction(GOSSIP_OPCODE_VENDOR));
 
   if (creature)
     SendGossipMenuFor(player, PET_GOSSIP_HELLO, creature->GetGUID());
@@ -444,227 +449,217 @@ void NpcBeastmaster::ShowMainMenu(Player *player, Creature *creature) {
   player->PlayDirectSound(PET_BEASTMASTER_HOWL);
 }
 
+constexpr std::array<NpcBeastmaster::GossipRoute, MAX_GOSSIP_OPCODES>
+    NpcBeastmaster::gossipRoutes = {{
+        {GOSSIP_OPCODE_NONE, &NpcBeastmaster::HandleNoAction, MAX_METRICS},
+        {GOSSIP_OPCODE_MAIN_MENU, &NpcBeastmaster::HandleMainMenu,
+         METRIC_GOSSIP_MAIN_MENU},
+        {GOSSIP_OPCODE_CATALOG_PAGE, &NpcBeastmaster::HandleCatalogPage,
+         METRIC_GOSSIP_CATALOG_PAGE},
+        {GOSSIP_OPCODE_ADOPT, &NpcBeastmaster::CreatePet, METRIC_CREATE_PET},
+        {GOSSIP_OPCODE_REMOVE_SKILLS, &NpcBeastmaster::HandleRemoveSkills,
+         METRIC_GOSSIP_REMOVE_SKILLS},
+        {GOSSIP_OPCODE_STABLE, &NpcBeastmaster::HandleStable,
+         METRIC_GOSSIP_STABLE},
+        {GOSSIP_OPCODE_VENDOR, &NpcBeastmaster::HandleVendor,
+         METRIC_GOSSIP_VENDOR},
+        {GOSSIP_OPCODE_TRACKED_MENU, &NpcBeastmaster::HandleTrackedMenu,
+         METRIC_GOSSIP_TRACKED_MENU},
+        {GOSSIP_OPCODE_TRACKED_SUMMON, &NpcBeastmaster::HandleTrackedSummon,
+         METRIC_GOSSIP_TRACKED_SUMMON},
+        {GOSSIP_OPCODE_TRACKED_RENAME, &NpcBeastmaster::HandleTrackedRename,
+         METRIC_GOSSIP_TRACKED_RENAME},
+        {GOSSIP_OPCODE_TRACKED_DELETE, &NpcBeastmaster::HandleTrackedDelete,
+         METRIC_GOSSIP_TRACKED_DELETE},
+    }};
+
 void NpcBeastmaster::GossipSelect(Player *player, Creature *creature,
                                   uint32 action) {
-  if (!sConfigMgr->GetOption<bool>("BeastMaster.Enable", true))
+  static_assert(
+      [] {
+        for (uint32 opcode = 0; opcode < MAX_GOSSIP_OPCODES; ++opcode)
+          if (gossipRoutes[opcode].opcode != opcode ||
+              !gossipRoutes[opcode].handler)
+            return false;
+        return true;
+      }(),
+      "every gossip opcode needs a route at its own index");
+
+  if (!GetConfig()->enabled)
     return;
 
+  if (!IsCatalogReady()) {
+    CloseGossipMenuFor(player);
+    return;
+  }
+
+  GossipRoute const &route = gossipRoutes[GetGossipOpcode(action)];
+  BeastmasterTimer timer(route.metric);
+
+  // Invalidates tracked pets queries still in flight for an older menu.
+  if (BeastmasterPlayerState *state = GetPlayerState(player))
+    ++state->menuToken;
+
   ClearGossipMenuFor(player);
+  (this->*route.handler)(player, creature, GetGossipPayload(action));
+}
 
-  if (action == PET_MAIN_MENU) {
-    ShowMainMenu(player, creature);
-  } else if (action >= PET_PAGE_START_PETS &&
-             action < PET_PAGE_START_EXOTIC_PETS) {
-    AddGossipItemFor(player, GOSSIP_ICON_TALK, "Back..", GOSSIP_SENDER_MAIN,
-                     PET_MAIN_MENU);
-    int page = action - PET_PAGE_START_PETS + 1;
-    int maxPage = normalPets.size() / PET_PAGE_SIZE +
-                  (normalPets.size() % PET_PAGE_SIZE != 0);
-
-    if (page > 1)
-      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Previous..",
-                       GOSSIP_SENDER_MAIN, PET_PAGE_START_PETS + page - 2);
-
-    if (page < maxPage)
-      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Next..",
-                       GOSSIP_SENDER_MAIN, PET_PAGE_START_PETS + page);
-
-    AddPetsToGossip(player, normalPets, page);
-    SendGossipMenuFor(player, PET_GOSSIP_BROWSE, creature->GetGUID());
-  } else if (action >= PET_PAGE_START_EXOTIC_PETS &&
-             action < PET_PAGE_START_RARE_PETS) {
-    if (!(player->HasSpell(PET_SPELL_BEAST_MASTERY) ||
-          player->HasTalent(PET_SPELL_BEAST_MASTERY,
-                            player->GetActiveSpec()))) {
-      player->addSpell(PET_SPELL_BEAST_MASTERY, SPEC_MASK_ALL, false);
-      std::ostringstream messageLearn;
-      messageLearn << "I have taught you the art of Beast Mastery, "
-                   << player->GetName() << ".";
-      creature->Whisper(messageLearn.str().c_str(), LANG_UNIVERSAL, player);
-    }
+void NpcBeastmaster::HandleNoAction(Player * /*player*/,
+                                    Creature * /*creature*/,
+                                    uint32 /*payload*/) {}
 
-    AddGossipItemFor(player, GOSSIP_ICON_TALK, "Back..", GOSSIP_SENDER_MAIN,
-                     PET_MAIN_MENU);
-    int page = action - PET_PAGE_START_EXOTIC_PETS + 1;
-    int maxPage = exoticPets.size() / PET_PAGE_SIZE +
-                  (exoticPets.size() % PET_PAGE_SIZE != 0);
+void NpcBeastmaster::HandleMainMenu(Player *player, Creature *creature,
+                                    uint32 /*payload*/) {
+  ShowMainMenu(player, creature);
+}
 
-    if (page > 1)
-      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Previous..",
-                       GOSSIP_SENDER_MAIN,
-                       PET_PAGE_START_EXOTIC_PETS + page - 2);
+void NpcBeastmaster::HandleCatalogPage(Player *player, Creature *creature,
+                                       uint32 payload) {
+  BeastmasterPetCategory category;
+  uint32 page;
+  if (!DecodeCatalogPagePayload(payload, category, page))
+    return;
 
-    if (page < maxPage)
-      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Next..",
-                       GOSSIP_SENDER_MAIN, PET_PAGE_START_EXOTIC_PETS + page);
+  if ((category == PET_CATEGORY_EXOTIC ||
+       category == PET_CATEGORY_RARE_EXOTIC) &&
+      !(player->HasSpell(PET_SPELL_BEAST_MASTERY) ||
+        player->HasTalent(PET_SPELL_BEAST_MASTERY, player->GetActiveSpec()))) {
+    player->addSpell(PET_SPELL_BEAST_MASTERY, SPEC_MASK_ALL, false);
+    std::ostringstream messageLearn;
+    messageLearn << "I have taught you the art of Beast Mastery, "
+                 << player->GetName() << ".";
+    creature->Whisper(messageLearn.str().c_str(), LANG_UNIVERSAL, player);
+  }
 
-    AddPetsToGossip(player, exoticPets, page);
-    SendGossipMenuFor(player, PET_GOSSIP_BROWSE, creature->GetGUID());
-  } else if (action >= PET_PAGE_START_RARE_PETS &&
-             action < PET_PAGE_START_RARE_EXOTIC_PETS) {
-    AddGossipItemFor(player, GOSSIP_ICON_TALK, "Back..", GOSSIP_SENDER_MAIN,
-                     PET_MAIN_MENU);
-    int page = action - PET_PAGE_START_RARE_PETS + 1;
-    int maxPage = rarePets.size() / PET_PAGE_SIZE +
-                  (rarePets.size() % PET_PAGE_SIZE != 0);
-
-    if (page > 1)
-      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Previous..",
-                       GOSSIP_SENDER_MAIN, PET_PAGE_START_RARE_PETS + page - 2);
-
-    if (page < maxPage)
-      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Next..",
-                       GOSSIP_SENDER_MAIN, PET_PAGE_START_RARE_PETS + page);
-
-    AddPetsToGossip(player, rarePets, page);
-    SendGossipMenuFor(player, PET_GOSSIP_BROWSE, creature->GetGUID());
-  } else if (action >= PET_PAGE_START_RARE_EXOTIC_PETS &&
-             action < PET_PAGE_MAX) {
-    if (!(player->HasSpell(PET_SPELL_BEAST_MASTERY) ||
-          player->HasTalent(PET_SPELL_BEAST_MASTERY,
-                            player->GetActiveSpec()))) {
-      player->addSpell(PET_SPELL_BEAST_MASTERY, SPEC_MASK_ALL, false);
-      std::ostringstream messageLearn;
-      messageLearn << "I have taught you the art of Beast Mastery, "
-                   << player->GetName() << ".";
-      creature->Whisper(messageLearn.str().c_str(), LANG_UNIVERSAL, player);
-    }
+  // Held for the whole call so a reload cannot free the pets we page through.
+  auto catalog = GetCatalog();
+  SendCatalogPage(player, creature, *catalog, category, page);
+}
 
-    AddGossipItemFor(player, GOSSIP_ICON_TALK, "Back..", GOSSIP_SENDER_MAIN,
-                     PET_MAIN_MENU);
-    int page = action - PET_PAGE_START_RARE_EXOTIC_PETS + 1;
-    int maxPage = rareExoticPets.size() / PET_PAGE_SIZE +
-                  (rareExoticPets.size() % PET_PAGE_SIZE != 0);
+void NpcBeastmaster::HandleRemoveSkills(Player *player, Creature * /*creature*/,
+                                        uint32 /*payload*/) {
+  for (auto spell : HunterSpells)
+    player->removeSpell(spell, SPEC_MASK_ALL, false);
 
-    if (page > 1)
-      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Previous..",
-                       GOSSIP_SENDER_MAIN,
-                       PET_PAGE_START_RARE_EXOTIC_PETS + page - 2);
+  player->removeSpell(PET_SPELL_BEAST_MASTERY, SPEC_MASK_ALL, false);
+  CloseGossipMenuFor(player);
+}
 
-    if (page < maxPage)
-      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Next..",
-                       GOSSIP_SENDER_MAIN,
-                       PET_PAGE_START_RARE_EXOTIC_PETS + page);
+void NpcBeastmaster::HandleStable(Player *player, Creature *creature,
+                                  uint32 /*payload*/) {
+  player->GetSession()->SendStablePet(creature->GetGUID());
+}
 
-    AddPetsToGossip(player, rareExoticPets, page);
-    SendGossipMenuFor(player, PET_GOSSIP_BROWSE, creature->GetGUID());
-  } else if (action == PET_REMOVE_SKILLS) {
-    for (auto spell : HunterSpells)
-      player->removeSpell(spell, SPEC_MASK_ALL, false);
+void NpcBeastmaster::HandleVendor(Player *player, Creature *creature,
+                                  uint32 /*payload*/) {
+  player->GetSession()->SendListInventory(creature->GetGUID());
+}
 
-    player->removeSpell(PET_SPELL_BEAST_MASTERY, SPEC_MASK_ALL, false);
-    CloseGossipMenuFor(player);
-  } else if (action == GOSSIP_OPTION_STABLEPET) {
-    player->GetSession()->SendStablePet(creature->GetGUID());
-  } else if (action == GOSSIP_OPTION_VENDOR) {
-    player->GetSession()->SendListInventory(creature->GetGUID());
-  } else if (action >= PET_TRACKED_PETS_MENU && action < PET_TRACKED_SUMMON) {
-    uint32 page = action - PET_TRACKED_PETS_MENU + 1;
-    ShowTrackedPetsMenu(player, creature, page);
+void NpcBeastmaster::HandleTrackedMenu(Player *player, Creature *creature,
+                                       uint32 seek) {
+  // Pages on from the page on screen; the client only says which way.
+  BeastmasterTrackedPageQuery query;
+  BeastmasterPlayerState *state = GetPlayerState(player);
+  if (state && state->trackedPage.first.entry) {
+    if (seek == TRACKED_SEEK_AFTER && state->trackedPage.hasNext)
+      query = state->trackedPage.GetNext();
+    else if (seek == TRACKED_SEEK_BEFORE && state->trackedPage.hasPrevious)
+      query = state->trackedPage.GetPrevious();
+  }
+  ShowTrackedPetsMenu(player, creature, query);
+}
+
+void NpcBeastmaster::HandleTrackedSummon(Player *player, Creature *creature,
+                                         uint32 index) {
+  BeastmasterPlayerState *state = GetPlayerState(player);
+  BeastmasterTrackedPet const *trackedPet =
+      state ? state->GetMenuPet(index) : nullptr;
+  if (!trackedPet)
     return;
-  } else if (action >= PET_TRACKED_SUMMON && action < PET_TRACKED_RENAME) {
-    uint32 idx = action - PET_TRACKED_SUMMON;
-    auto *petMapWrap =
-        player->CustomData.Get<BeastmasterPetMap>("BeastmasterMenuPetMap");
-    if (!petMapWrap || petMapWrap->map.find(idx) == petMapWrap->map.end())
-      return;
-    uint32 entry = petMapWrap->map[idx];
-    if (player->IsExistPet()) {
-      creature->Whisper("First you must abandon or stable your current pet!",
-                        LANG_UNIVERSAL, player);
-      CloseGossipMenuFor(player);
-      return;
-    } else {
-      Pet *pet = player->CreatePet(entry, PET_SPELL_CALL_PET);
-      if (pet) {
-        QueryResult nameResult =
-            CharacterDatabase.Query("SELECT name FROM beastmaster_tamed_pets "
-                                    "WHERE owner_guid = {} AND entry = {}",
-                                    player->GetGUID().GetCounter(), entry);
-        if (nameResult) {
-          std::string customName = (*nameResult)[0].Get<std::string>();
-          pet->SetName(customName);
-        }
-        pet->SetPower(POWER_HAPPINESS, PET_MAX_HAPPINESS);
-        creature->Whisper("Your tracked pet has been summoned!", LANG_UNIVERSAL,
-                          player);
-      } else {
-        creature->Whisper("Failed to summon pet.", LANG_UNIVERSAL, player);
-      }
-    }
+  // Copied: the menu closes either way.
+  BeastmasterTrackedPet summoned = *trackedPet;
+  state->ResetMenu();
+
+  if (player->IsExistPet()) {
+    creature->Whisper("First you must abandon or stable your current pet!",
+                      LANG_UNIVERSAL, player);
     CloseGossipMenuFor(player);
     return;
-  } else if (action >= PET_TRACKED_RENAME && action < PET_TRACKED_DELETE) {
-    uint32 idx = action - PET_TRACKED_RENAME;
-    auto *petMapWrap =
-        player->CustomData.Get<BeastmasterPetMap>("BeastmasterMenuPetMap");
-    if (!petMapWrap || petMapWrap->map.find(idx) == petMapWrap->map.end())
-      return;
-    uint32 entry = petMapWrap->map[idx];
-    player->CustomData.Set("BeastmasterRenamePetEntry",
-                           new BeastmasterUInt32(entry));
-    player->CustomData.Set("BeastmasterExpectRename",
-                           new BeastmasterBool(true));
-    ChatHandler(player->GetSession())
-        .PSendSysMessage("To rename your pet, type: .petname rename <newname> "
-                         "in chat. To cancel, type: .petname cancel");
-    if (creature)
-      creature->Whisper(
-          "To rename your pet, type: .petname rename <newname> in chat. "
-          "To cancel, type: .petname cancel",
-          LANG_UNIVERSAL, player);
-    CloseGossipMenuFor(player);
+  }
+
+  Pet *pet = player->CreatePet(summoned.entry, PET_SPELL_CALL_PET);
+  if (pet) {
+    pet->SetName(std::string(summoned.GetName()));
+    pet->SetPower(POWER_HAPPINESS, PET_MAX_HAPPINESS);
+    creature->Whisper("Your tracked pet has been summoned!", LANG_UNIVERSAL,
+                      player);
+  } else {
+    creature->Whisper("Failed to summon pet.", LANG_UNIVERSAL, player);
+  }
+  CloseGossipMenuFor(player);
+}
+
+void NpcBeastmaster::HandleTrackedRename(Player *player, Creature *creature,
+                                         uint32 index) {
+  BeastmasterPlayerState *state = GetPlayerState(player);
+  uint32 entry = state ? state->GetMenuEntry(index) : 0;
+  if (!entry)
     return;
-  } else if (action >= PET_TRACKED_DELETE &&
-             action < PET_TRACKED_DELETE + 1000) {
-    uint32 idx = action - PET_TRACKED_DELETE;
-    auto *petMapWrap =
-        player->CustomData.Get<BeastmasterPetMap>("BeastmasterMenuPetMap");
-    if (!petMapWrap || petMapWrap->map.find(idx) == petMapWrap->map.end())
-      return;
-    uint32 entry = petMapWrap->map[idx];
-
-    CharacterDatabase.Execute("DELETE FROM beastmaster_tamed_pets WHERE "
-                              "owner_guid = {} AND entry = {}",
-                              player->GetGUID().GetCounter(), entry);
-
-    sNpcBeastMaster->ClearTrackedPetsCache(player);
-
-    ChatHandler(player->GetSession())
-        .PSendSysMessage("Tracked pet deleted (entry {}).", entry);
-    LOG_INFO("module", "Beastmaster: Player {} deleted tracked pet (entry {}).",
-             player->GetGUID().GetCounter(), entry);
-
-    uint32 totalPets = 0;
-    QueryResult result = CharacterDatabase.Query(
-        "SELECT COUNT(*) FROM beastmaster_tamed_pets WHERE owner_guid = {}",
-        player->GetGUID().GetCounter());
-    if (result)
-      totalPets = (*result)[0].Get<uint32>();
-
-    uint32 page = (idx / PET_TRACKED_PAGE_SIZE) + 1;
-    uint32 maxPage =
-        (totalPets + PET_TRACKED_PAGE_SIZE - 1) / PET_TRACKED_PAGE_SIZE;
-    if (page > maxPage && maxPage > 0)
-      page = maxPage;
-    if (page == 0)
-      page = 1;
-
-    ShowTrackedPetsMenu(player, creature, page);
+  state->ResetMenu();
+  state->SetPendingRename(entry);
+  ChatHandler(player->GetSession())
+      .PSendSysMessage("To rename your pet, type: .petname rename <newname> "
+                       "in chat. To cancel, type: .petname cancel");
+  if (creature)
+    creature->Whisper(
+        "To rename your pet, type: .petname rename <newname> in chat. "
+        "To cancel, type: .petname cancel",
+        LANG_UNIVERSAL, player);
+  CloseGossipMenuFor(player);
+}
+
+void NpcBeastmaster::HandleTrackedDelete(Player *player, Creature *creature,
+                                         uint32 index) {
+  BeastmasterPlayerState *state = GetPlayerState(player);
+  uint32 entry = state ? state->GetMenuEntry(index) : 0;
+  if (!entry)
     return;
-  }
 
-  if (action >= PET_PAGE_MAX)
-    CreatePet(player, creature, action);
+  journal.Delete(player->GetGUID().GetCounter(), entry);
+  state->RemoveTamed(entry);
+
+  // Patch the cache rather than re-querying: the DELETE is still pending.
+  RemoveTrackedPetFromCache(player, entry);
+
+  ChatHandler(player->GetSession())
+      .PSendSysMessage("Tracked pet deleted (entry {}).", entry);
+  LOG_INFO("module", "Beastmaster: Player {} deleted tracked pet (entry {}).",
+           player->GetGUID().GetCounter(), entry);
+
+  // Stay on the page, now without the pet; an emptied page gives way to a
+  // neighbour.
+  BeastmasterTrackedPageInfo &page = state->trackedPage;
+  BeastmasterTrackedPageQuery query = page.query;
+  TrackedPetList trackedPets;
+  if (GetTrackedPetsFromCache(player, trackedPets)) {
+    if (!trackedPets.empty())
+      page.SetBounds(trackedPets);
+    else if (page.hasPrevious)
+      query = page.GetPrevious();
+    else if (page.hasNext)
+      query = page.GetNext();
+  }
+  ShowTrackedPetsMenu(player, creature, query);
 }
 
 void NpcBeastmaster::CreatePet(Player *player, Creature *creature,
-                               uint32 action) {
-  if (!sConfigMgr->GetOption<bool>("BeastMaster.Enable", true))
+                               uint32 petEntry) {
+  auto config = GetConfig();
+  if (!config->enabled)
     return;
 
-  uint32 petEntry = action - PET_PAGE_MAX;
-  const PetInfo *info = FindPetInfo(petEntry);
+  auto catalog = GetCatalog();
+  auto info = catalog->Find(petEntry);
 
   if (player->IsExistPet()) {
     creature->Whisper("First you must abandon or stable your current pet!",
@@ -673,16 +668,17 @@ void NpcBeastmaster::CreatePet(Player *player, Creature *creature,
     return;
   }
 
-  if (info && info->rarity == "exotic" && player->getClass() != CLASS_HUNTER &&
-      !beastmasterConfig.allowExotic) {
+  if (info && info->rarity == PET_RARITY_EXOTIC &&
+      player->getClass() != CLASS_HUNTER && !config->allowExotic) {
     creature->Whisper("Only hunters can adopt exotic pets.", LANG_UNIVERSAL,
                       player);
     CloseGossipMenuFor(player);
     return;
   }
 
-  if (info && info->rarity == "exotic" && player->getClass() == CLASS_HUNTER &&
-      beastmasterConfig.hunterBeastMasteryRequired) {
+  if (info && info->rarity == PET_RARITY_EXOTIC &&
+      player->getClass() == CLASS_HUNTER &&
+      config->hunterBeastMasteryRequired) {
     if (!player->HasTalent(PET_SPELL_BEAST_MASTERY, player->GetActiveSpec())) {
       creature->Whisper(
           "You need the Beast Mastery talent to adopt exotic pets.",
@@ -693,13 +689,19 @@ void NpcBeastmaster::CreatePet(Player *player, Creature *creature,
   }
 
   // Enforce max tracked pets if enabled
-  if (beastmasterConfig.trackTamedPets &&
-      beastmasterConfig.maxTrackedPets > 0) {
-    QueryResult result = CharacterDatabase.Query(
-        "SELECT COUNT(*) FROM beastmaster_tamed_pets WHERE owner_guid = {}",
-        player->GetGUID().GetCounter());
-    uint32 count = result ? (*result)[0].Get<uint32>() : 0;
-    if (count >= beastmasterConfig.maxTrackedPets) {
+  if (config->trackTamedPets && config->maxTrackedPets > 0) {
+    BeastmasterPlayerState *state = GetPlayerState(player);
+    if (!state || !state->IsTamedLoaded()) {
+      // Tracking may have been switched on by a reload after this login.
+      if (!state)
+        LoadPlayerState(player);
+      creature->Whisper("I am still looking up your tamed pets, please try "
+                        "again in a moment.",
+                        LANG_UNIVERSAL, player);
+      CloseGossipMenuFor(player);
+      return;
+    }
+    if (state->GetTamedCount() >= config->maxTrackedPets) {
       creature->Whisper("You have reached the maximum number of tracked pets.",
                         LANG_UNIVERSAL, player);
       CloseGossipMenuFor(player);
@@ -716,9 +718,16 @@ void NpcBeastmaster::CreatePet(Player *player, Creature *creature,
     return;
   }
 
-  if (beastmasterConfig.trackTamedPets)
+  if (config->trackTamedPets)
     BeastmasterDB::TrackTamedPet(player, petEntry, pet->GetName());
 
+  static_assert(COUNTER_ADOPTIONS_RARE_EXOTIC - COUNTER_ADOPTIONS_NORMAL ==
+                uint32(PET_CATEGORY_RARE_EXOTIC));
+  BeastmasterMetrics::Increment(BeastmasterCounter(
+      uint32(COUNTER_ADOPTIONS_NORMAL) +
+      GetPetCategory(GetTameRules(*config), petEntry,
+                     info ? info->rarity : PET_RARITY_NORMAL)));
+
   pet->SetPower(POWER_HAPPINESS, PET_MAX_HAPPINESS);
 
   if (player->getClass() != CLASS_HUNTER) {
@@ -737,117 +746,212 @@ void NpcBeastmaster::CreatePet(Player *player, Creature *creature,
   CloseGossipMenuFor(player);
 }
 
-void NpcBeastmaster::AddPetsToGossip(Player *player,
-                                     std::vector<PetInfo> const &pets,
+void NpcBeastmaster::SendCatalogPage(Player *player, Creature *creature,
+                                     BeastmasterCatalog const &catalog,
+                                     BeastmasterPetCategory category,
                                      uint32 page) {
-  std::set<uint32> tamedEntries;
-  QueryResult result = CharacterDatabase.Query(
-      "SELECT entry FROM beastmaster_tamed_pets WHERE owner_guid = {}",
-      player->GetGUID().GetCounter());
-  if (result) {
-    do {
-      Field *fields = result->Fetch();
-      tamedEntries.insert(fields[0].Get<uint32>());
-    } while (result->NextRow());
-  }
+  // Prefetched at login; pages render without overlay until it arrives.
+  BeastmasterPlayerState *state = GetPlayerState(player);
+  if (state && !state->IsTamedLoaded())
+    state = nullptr;
 
-  uint32 count = 1;
-  for (const auto &pet : pets) {
-    if (count > (page - 1) * PET_PAGE_SIZE && count <= page * PET_PAGE_SIZE) {
-      if (tamedEntries.count(pet.entry)) {
-        AddGossipItemFor(player, GOSSIP_ICON_CHAT,
-                         pet.name + " (Already Tamed)", GOSSIP_SENDER_MAIN,
-                         0); // 0 = no action
-      } else {
-        AddGossipItemFor(player, pet.icon, pet.name, GOSSIP_SENDER_MAIN,
-                         pet.entry + PET_PAGE_MAX);
-      }
-    }
-    count++;
+  auto items = catalog.GetGossipPages().GetPage(category, page);
+  if (items.empty()) // Page of an older, larger catalog
+    AddGossipItemFor(player, GOSSIP_ICON_TALK, "Back..", GOSSIP_SENDER_MAIN,
+                     EncodeGossipAction(GOSSIP_OPCODE_MAIN_MENU));
+
+  for (auto const &item : items) {
+    if (item.row != BeastmasterGossipItem::NO_ROW && state &&
+        state->IsTamedRow(catalog, item.row))
+      AddGossipItemFor(player, GOSSIP_ICON_CHAT, item.tamedText,
+                       GOSSIP_SENDER_MAIN,
+                       EncodeGossipAction(GOSSIP_OPCODE_NONE));
+    else
+      AddGossipItemFor(player, item.icon, item.text, GOSSIP_SENDER_MAIN,
+                       item.action);
   }
+
+  SendGossipMenuFor(player, PET_GOSSIP_BROWSE, creature->GetGUID());
 }
 
 void NpcBeastmaster::ClearTrackedPetsCache(Player *player) {
-  std::lock_guard<std::mutex> lock(trackedPetsCacheMutex);
-  trackedPetsCache.erase(player->GetGUID().GetRawValue());
-  player->CustomData.Erase("BeastmasterMenuPetMap");
+  trackedPetsCache.Erase(player->GetGUID().GetRawValue());
+  if (BeastmasterPlayerState *state = GetPlayerState(player))
+    state->ResetMenu();
 }
 
-void NpcBeastmaster::ShowTrackedPetsMenu(Player *player, Creature *creature,
-                                         uint32 page /*= 1*/) {
+void NpcBeastmaster::RemoveTrackedPetFromCache(Player *player, uint32 entry) {
+  trackedPetsCache.Modify(
+      player->GetGUID().GetRawValue(), [entry](TrackedPetList &pets) {
+        pets.erase(std::remove_if(pets.begin(), pets.end(),
+                                  [entry](auto const &pet) {
+                                    return pet.entry == entry;
+                                  }),
+                   pets.end());
+      });
+}
+
+void NpcBeastmaster::RenameTrackedPetInCache(Player *player, uint32 entry,
+                                             std::string const &name) {
+  trackedPetsCache.Modify(player->GetGUID().GetRawValue(),
+                          [entry, &name](TrackedPetList &pets) {
+                            for (auto &pet : pets)
+                              if (pet.entry == entry)
+                                pet.SetName(name);
+                          });
+}
+
+bool NpcBeastmaster::GetTrackedPetsFromCache(Player *player,
+                                             TrackedPetList &pets) {
+  return trackedPetsCache.Get(player->GetGUID().GetRawValue(), pets);
+}
+
+void NpcBeastmaster::ShowTrackedPetsMenu(
+    Player *player, Creature *creature,
+    BeastmasterTrackedPageQuery query /*= {}*/) {
+  BeastmasterTimer timer(METRIC_SHOW_TRACKED_PETS_MENU);
   ClearGossipMenuFor(player);
 
-  uint64 guid = player->GetGUID().GetRawValue();
-  std::vector<std::tuple<uint32, std::string, std::string>> *trackedPetsPtr =
-      nullptr;
+  BeastmasterPlayerState *state = GetPlayerState(player);
+  if (!state) {
+    LoadPlayerState(player);
+    state = GetPlayerState(player);
+  }
+  uint32 menuToken = ++state->menuToken;
 
-  {
-    std::lock_guard<std::mutex> lock(trackedPetsCacheMutex);
-    auto it = trackedPetsCache.find(guid);
-    if (it != trackedPetsCache.end()) {
-      trackedPetsPtr = &it->second;
-    }
+  // The cache holds the page last shown, e.g. the first page on reopening.
+  TrackedPetList trackedPets;
+  if (state->trackedPage.query == query &&
+      GetTrackedPetsFromCache(player, trackedPets)) {
+    SendTrackedPetsPage(player, creature, trackedPets, state->trackedPage);
+    return;
   }
 
-  if (!trackedPetsPtr) {
-    std::vector<std::tuple<uint32, std::string, std::string>> trackedPets;
-    QueryResult result = CharacterDatabase.Query(
-        "SELECT entry, name, date_tamed FROM beastmaster_tamed_pets WHERE "
-        "owner_guid = {} ORDER BY date_tamed DESC",
-        player->GetGUID().GetCounter());
-
-    if (result) {
-      do {
-        Field *fields = result->Fetch();
-        uint32 entry = fields[0].Get<uint32>();
-        std::string name = fields[1].Get<std::string>();
-        std::string date = fields[2].Get<std::string>();
-        trackedPets.emplace_back(entry, name, date);
-      } while (result->NextRow());
-    }
-    {
-      std::lock_guard<std::mutex> lock(trackedPetsCacheMutex);
-      trackedPetsCache[guid] = std::move(trackedPets);
-      trackedPetsPtr = &trackedPetsCache[guid];
-    }
+  // Cache miss: query the page off the map thread and send the gossip on
+  // arrival.
+  ObjectGuid playerGuid = player->GetGUID();
+  ObjectGuid creatureGuid = creature ? creature->GetGUID() : ObjectGuid::Empty;
+  BeastmasterStatement stmt(query.seek == TRACKED_SEEK_AFTER
+                                ? BM_CHAR_SEL_TAMED_PETS_AFTER
+                            : query.seek == TRACKED_SEEK_BEFORE
+                                ? BM_CHAR_SEL_TAMED_PETS_BEFORE
+                                : BM_CHAR_SEL_TAMED_PETS);
+  uint8 index = 0;
+  stmt.SetData(index++, playerGuid.GetCounter());
+  if (query.seek != TRACKED_SEEK_FIRST) {
+    stmt.SetData(index++, uint32(query.key.tamedAt));
+    stmt.SetData(index++, uint32(query.key.tamedAt));
+    stmt.SetData(index++, query.key.entry);
+  }
+  stmt.SetData(index, TRACKED_PAGE_QUERY_LIMIT);
+  player->GetSession()->GetQueryProcessor().AddCallback(
+      BeastmasterDB::AsyncQuery(
+          stmt,
+          [playerGuid, creatureGuid, query, menuToken](QueryResult result) {
+            sNpcBeastMaster->HandleTrackedPetsResult(
+                playerGuid, creatureGuid, query, menuToken, std::move(result));
+          }));
+}
+
+void NpcBeastmaster::HandleTrackedPetsResult(ObjectGuid playerGuid,
+                                             ObjectGuid creatureGuid,
+                                             BeastmasterTrackedPageQuery query,
+                                             uint32 menuToken,
+                                             QueryResult result) {
+  Player *player = ObjectAccessor::FindPlayer(playerGuid);
+  if (!player)
+    return; // Logged out while the query was in flight.
+
+  // Any later gossip interaction bumps the token and may have changed the
+  // tracked pets, so this result is neither cached nor shown.
+  BeastmasterPlayerState *state = GetPlayerState(player);
+  if (!state || state->menuToken != menuToken)
+    return;
+
+  TrackedPetList rows;
+  if (result) {
+    rows.reserve(result->GetRowCount());
+    do {
+      Field *fields = result->Fetch();
+      uint32 entry = fields[0].Get<uint32>();
+      std::string name = fields[1].Get<std::string>();
+      time_t tamedAt = time_t(fields[2].Get<uint64>());
+      rows.emplace_back(entry, name, tamedAt);
+    } while (result->NextRow());
+  }
+
+  BeastmasterTrackedPageBuilder builder(query, std::move(rows));
+  ApplyPendingWrites(playerGuid.GetCounter(), builder);
+  TrackedPetList trackedPets;
+  BeastmasterTrackedPageInfo page = builder.Build(trackedPets);
+
+  Creature *creature = nullptr;
+  if (!creatureGuid.IsEmpty()) {
+    creature = ObjectAccessor::GetCreature(*player, creatureGuid);
+    if (!creature || !creature->IsWithinDistInMap(player, INTERACTION_DISTANCE))
+      return; // The player walked away from the beastmaster.
   }
 
-  const auto &trackedPets = *trackedPetsPtr;
-  uint32 total = trackedPets.size();
-  uint32 offset = (page - 1) * PET_TRACKED_PAGE_SIZE;
-  uint32 shown = 0;
+  // The pets around the page were deleted since it was left; start over.
+  if (trackedPets.empty() && query.seek != TRACKED_SEEK_FIRST) {
+    ShowTrackedPetsMenu(player, creature);
+    return;
+  }
+
+  trackedPetsCache.Put(playerGuid.GetRawValue(), trackedPets);
+  SendTrackedPetsPage(player, creature, trackedPets, page);
+}
+
+void NpcBeastmaster::SendTrackedPetsPage(
+    Player *player, Creature *creature, TrackedPetList const &trackedPets,
+    BeastmasterTrackedPageInfo const &page) {
+  ClearGossipMenuFor(player);
+
+  BeastmasterPlayerState *state = GetPlayerState(player);
+  if (state) {
+    state->trackedPage = page;
+    state->ResetMenu();
+  }
 
-  std::map<uint32, uint32> menuPetIndexToEntry;
+  auto catalog = GetCatalog();
 
-  // Build the menu for this page
-  for (uint32 i = offset; i < total && shown < PET_TRACKED_PAGE_SIZE;
-       ++i, ++shown) {
-    const auto &petTuple = trackedPets[i];
-    uint32 entry = std::get<0>(petTuple);
-    const std::string &name = std::get<1>(petTuple);
-    const PetInfo *info = FindPetInfo(entry);
+  // Three items per pet plus Previous and Next: 32, all a gossip menu holds.
+  for (uint32 idx = 0;
+       idx < trackedPets.size() && idx < PET_TRACKED_PAGE_SIZE; ++idx) {
+    uint32 entry = trackedPets[idx].entry;
+    std::string name(trackedPets[idx].GetName());
+    auto info = catalog->Find(entry);
 
     std::string label;
     if (info)
       label =
-          Acore::StringFormat("{} [{}, {}]", name, info->name, info->rarity);
+          Acore::StringFormat("{} [{}, {}]", name, info->name,
+                              BeastmasterCatalog::GetRarityName(info->rarity));
     else
       label = name;
 
-    // Use shown as the unique index for this page
-    uint32 idx = shown;
-    menuPetIndexToEntry[idx] = entry;
+    if (state)
+      state->AddMenuEntry(trackedPets[idx]);
 
     AddGossipItemFor(player, GOSSIP_ICON_TAXI, "Summon: " + label,
-                     GOSSIP_SENDER_MAIN, PET_TRACKED_SUMMON + idx);
+                     GOSSIP_SENDER_MAIN,
+                     EncodeGossipAction(GOSSIP_OPCODE_TRACKED_SUMMON, idx));
     AddGossipItemFor(player, GOSSIP_ICON_TRAINER, "Rename: " + label,
-                     GOSSIP_SENDER_MAIN, PET_TRACKED_RENAME + idx);
+                     GOSSIP_SENDER_MAIN,
+                     EncodeGossipAction(GOSSIP_OPCODE_TRACKED_RENAME, idx));
     AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "Delete: " + label,
-                     GOSSIP_SENDER_MAIN, PET_TRACKED_DELETE + idx);
+                     GOSSIP_SENDER_MAIN,
+                     EncodeGossipAction(GOSSIP_OPCODE_TRACKED_DELETE, idx));
   }
-  // Store the mapping for this menu page
-  player->CustomData.Set("BeastmasterMenuPetMap",
-                         new BeastmasterPetMap(menuPetIndexToEntry));
+
+  if (page.hasPrevious)
+    AddGossipItemFor(
+        player, GOSSIP_ICON_TALK, "Previous..", GOSSIP_SENDER_MAIN,
+        EncodeGossipAction(GOSSIP_OPCODE_TRACKED_MENU, TRACKED_SEEK_BEFORE));
+  if (page.hasNext)
+    AddGossipItemFor(
+        player, GOSSIP_ICON_TALK, "Next..", GOSSIP_SENDER_MAIN,
+        EncodeGossipAction(GOSSIP_OPCODE_TRACKED_MENU, TRACKED_SEEK_AFTER));
 
   // Send the menu to the player
   if (creature)
@@ -856,12 +960,142 @@ void NpcBeastmaster::ShowTrackedPetsMenu(Player *player, Creature *creature,
     SendGossipMenuFor(player, PET_GOSSIP_BROWSE, ObjectGuid::Empty);
 }
 
-void NpcBeastmaster::PlayerUpdate(Player *player) {
-  if (beastmasterConfig.keepPetHappy && player->GetPet()) {
-    Pet *pet = player->GetPet();
-    if (pet->getPetType() == HUNTER_PET)
-      pet->SetPower(POWER_HAPPINESS, PET_MAX_HAPPINESS);
+void NpcBeastmaster::OnPetInitialized(Player *player) {
+  if (GetConfig()->keepPetHappy)
+    happinessKeeper.Register(player);
+}
+
+void NpcBeastmaster::OnPlayerLogin(Player *player) {
+  if (GetConfig()->trackTamedPets)
+    LoadPlayerState(player);
+}
+
+void NpcBeastmaster::LoadPlayerState(Player *player) {
+  auto *state = new BeastmasterPlayerState();
+  state->loadToken = ++playerStateToken;
+  player->CustomData.Set(BeastmasterPlayerState::KEY, state);
+  // The cached page is only found through the state it was shown with.
+  trackedPetsCache.Erase(player->GetGUID().GetRawValue());
+
+  ObjectGuid guid = player->GetGUID();
+  uint32 token = state->loadToken;
+  BeastmasterStatement stmt(BM_CHAR_SEL_TAMED_PET_ENTRIES);
+  stmt.SetData(0, guid.GetCounter());
+  player->GetSession()->GetQueryProcessor().AddCallback(
+      BeastmasterDB::AsyncQuery(stmt, [guid, token](QueryResult result) {
+        Player *player = ObjectAccessor::FindPlayer(guid);
+        if (!player)
+          return;
+        BeastmasterPlayerState *state = GetPlayerState(player);
+        if (!state || state->loadToken != token)
+          return; // Logged out, or a newer login is loading.
+
+        std::vector<uint32> entries;
+        if (result) {
+          entries.reserve(result->GetRowCount());
+          do {
+            entries.push_back(result->Fetch()[0].Get<uint32>());
+          } while (result->NextRow());
+        }
+        sNpcBeastMaster->ApplyPendingWrites(guid.GetCounter(), entries);
+        state->SetTamedEntries(std::move(entries));
+      }));
+}
+
+void NpcBeastmaster::OnPlayerLogout(Player *player) {
+  happinessKeeper.Unregister(player);
+  journal.FlushOwner(player->GetGUID().GetCounter());
+  trackedPetsCache.Erase(player->GetGUID().GetRawValue());
+  player->CustomData.Erase(BeastmasterPlayerState::KEY);
+}
+
+void NpcBeastmaster::ApplyPendingWrites(uint32 owner,
+                                        std::vector<uint32> &entries) const {
+  for (auto const &op : journal.GetPending(owner)) {
+    entries.erase(std::remove(entries.begin(), entries.end(), op.entry),
+                  entries.end());
+    if (op.type != BeastmasterJournalQueue::OP_DELETE)
+      entries.push_back(op.entry);
+  }
+}
+
+void NpcBeastmaster::ApplyPendingWrites(
+    uint32 owner, BeastmasterTrackedPageBuilder &page) const {
+  ApplyPendingOps(journal.GetPending(owner), page);
+}
+
+void NpcBeastmaster::UpdateWorld(uint32 diff) {
+  auto config = GetConfig();
+  journal.Update(diff, config->journalFlushInterval);
+
+  if (!config->profanityFilter)
+    return;
+
+  profanityCheckTimer += diff;
+  bool force = profanityReloadRequested.load(std::memory_order_relaxed);
+  if (!force && profanityCheckTimer < config->profanityCheckInterval)
+    return;
+
+  // One check at a time; the next update retries while one is running.
+  if (profanityReload.valid() &&
+      profanityReload.wait_for(std::chrono::seconds(0)) !=
+          std::future_status::ready)
+    return;
+
+  profanityCheckTimer = 0;
+  profanityReloadRequested.store(false, std::memory_order_relaxed);
+  profanityReload = std::async(std::launch::async, [this, config, force]() {
+    ReloadProfanityFilter(*config, force);
+  });
+}
+
+void NpcBeastmaster::ReloadProfanityFilter(BeastmasterConfig const &config,
+                                           bool force) {
+  struct stat fileStat;
+  time_t mtime = stat(config.profanityFile.c_str(), &fileStat) == 0
+                     ? fileStat.st_mtime
+                     : 0;
+  if (!force && mtime == profanityFileTime)
+    return;
+  profanityFileTime = mtime;
+
+  std::vector<std::string> words;
+  if (!mtime ||
+      !BeastmasterProfanityFilter::ReadWordList(config.profanityFile, words)) {
+    LOG_WARN("module",
+             "Beastmaster: Could not open {}, skipping profanity filter.",
+             config.profanityFile);
+    profanitySnapshot.Publish(nullptr);
+    return;
   }
+
+  uint32 start = getMSTime();
+  auto filter = std::make_shared<BeastmasterProfanityFilter>(
+      words, config.profanityLeetspeak);
+  LOG_INFO("module",
+           "Beastmaster: Compiled {} profane words into {} states ({} bytes) "
+           "in {} ms.",
+           filter->GetWordCount(), filter->GetStateCount(),
+           filter->GetMemoryUsage(), GetMSTimeDiffToNow(start));
+  profanitySnapshot.Publish(std::move(filter));
+}
+
+void NpcBeastmaster::OnShutdown() {
+  exporter.Stop();
+  journal.Flush(true);
+  if (catalogLoad.valid())
+    catalogLoad.wait();
+  if (profanityReload.valid())
+    profanityReload.wait();
+}
+
+void NpcBeastmaster::UpdateMap(Map *map, uint32 diff) {
+  happinessKeeper.Update(map, diff);
+}
+
+void NpcBeastmaster::OnMapDestroyed(Map *map) {
+  happinessKeeper.RemoveMap(map);
+  summonPool.RemoveMap(map);
 }
 
 // Chat handler to process the rename and delete confirmations
@@ -880,26 +1114,62 @@ public:
     return true;
   }
 
+  // Sleeps while no player is within visibility range: no events tick and
+  // UpdateAI returns at once. A player moving into sight wakes it.
   struct beastmasterAI : public ScriptedAI {
     beastmasterAI(Creature *creature) : ScriptedAI(creature) {}
 
-    void Reset() override {
-      events.ScheduleEvent(BEASTMASTER_EVENT_EAT, urand(30000, 90000));
+    void Reset() override { Wake(); }
+
+    void MoveInLineOfSight(Unit *who) override {
+      if (!awake && who->IsPlayer())
+        Wake();
+      ScriptedAI::MoveInLineOfSight(who);
     }
 
     void UpdateAI(uint32 diff) override {
+      if (!awake)
+        return;
+
       events.Update(diff);
+      while (uint32 eventId = events.ExecuteEvent()) {
+        if (eventId == BEASTMASTER_EVENT_IDLE_CHECK) {
+          if (!me->SelectNearestPlayer(me->GetVisibilityRange())) {
+            Sleep();
+            return;
+          }
+          events.ScheduleEvent(BEASTMASTER_EVENT_IDLE_CHECK,
+                               BEASTMASTER_IDLE_CHECK_INTERVAL);
+          continue;
+        }
 
-      switch (events.ExecuteEvent()) {
-      case BEASTMASTER_EVENT_EAT:
-        me->HandleEmoteCommand(EMOTE_ONESHOT_EAT_NO_SHEATHE);
-        events.ScheduleEvent(BEASTMASTER_EVENT_EAT, urand(30000, 90000));
-        break;
+        auto const &behaviour =
+            AmbientBehaviours[eventId - BEASTMASTER_EVENT_AMBIENT];
+        me->HandleEmoteCommand(behaviour.emote);
+        events.ScheduleEvent(eventId,
+                             urand(behaviour.minDelay, behaviour.maxDelay));
       }
     }
 
   private:
+    void Wake() {
+      awake = true;
+      events.Reset();
+      events.ScheduleEvent(BEASTMASTER_EVENT_IDLE_CHECK,
+                           BEASTMASTER_IDLE_CHECK_INTERVAL);
+      for (uint32 i = 0; i < std::size(AmbientBehaviours); ++i)
+        events.ScheduleEvent(BEASTMASTER_EVENT_AMBIENT + i,
+                             urand(AmbientBehaviours[i].minDelay,
+                                   AmbientBehaviours[i].maxDelay));
+    }
+
+    void Sleep() {
+      awake = false;
+      events.Reset();
+    }
+
     EventMap events;
+    bool awake = false;
   };
 
   CreatureAI *GetAI(Creature *creature) const override {
@@ -911,23 +1181,48 @@ class BeastMaster_WorldScript : public WorldScript {
 public:
   BeastMaster_WorldScript()
       : WorldScript("BeastMaster_WorldScript",
-                    {WORLDHOOK_ON_BEFORE_CONFIG_LOAD}) {}
+                    {WORLDHOOK_ON_BEFORE_CONFIG_LOAD, WORLDHOOK_ON_UPDATE,
+                     WORLDHOOK_ON_SHUTDOWN}) {}
 
   void OnBeforeConfigLoad(bool /*reload*/) override {
     sNpcBeastMaster->LoadSystem();
   }
+
+  void OnUpdate(uint32 diff) override { sNpcBeastMaster->UpdateWorld(diff); }
+
+  void OnShutdown() override { sNpcBeastMaster->OnShutdown(); }
+};
+
+class BeastMaster_AllMapScript : public AllMapScript {
+public:
+  BeastMaster_AllMapScript()
+      : AllMapScript("BeastMaster_AllMapScript",
+                     {ALLMAPHOOK_ON_MAP_UPDATE, ALLMAPHOOK_ON_DESTROY_MAP}) {}
+
+  void OnMapUpdate(Map *map, uint32 diff) override {
+    sNpcBeastMaster->UpdateMap(map, diff);
+  }
+
+  void OnDestroyMap(Map *map) override {
+    sNpcBeastMaster->OnMapDestroyed(map);
+  }
 };
 
 class BeastMaster_PlayerScript : public PlayerScript {
 public:
   BeastMaster_PlayerScript()
       : PlayerScript("BeastMaster_PlayerScript",
-                     {PLAYERHOOK_ON_BEFORE_UPDATE,
+                     {PLAYERHOOK_ON_LOGIN, PLAYERHOOK_ON_LOGOUT,
                       PLAYERHOOK_ON_BEFORE_LOAD_PET_FROM_DB,
-                      PLAYERHOOK_ON_BEFORE_GUARDIAN_INIT_STATS_FOR_LEVEL}) {}
+                      PLAYERHOOK_ON_BEFORE_GUARDIAN_INIT_STATS_FOR_LEVEL,
+                      PLAYERHOOK_ON_AFTER_GUARDIAN_INIT_STATS_FOR_LEVEL}) {}
+
+  void OnPlayerLogin(Player *player) override {
+    sNpcBeastMaster->OnPlayerLogin(player);
+  }
 
-  void OnPlayerBeforeUpdate(Player *player, uint32 /*p_time*/) override {
-    sNpcBeastMaster->PlayerUpdate(player);
+  void OnPlayerLogout(Player *player) override {
+    sNpcBeastMaster->OnPlayerLogout(player);
   }
 
   void OnPlayerBeforeLoadPetFromDB(Player * /*player*/, uint32 & /*petentry*/,
@@ -943,6 +1238,12 @@ public:
     if (cinfo->IsTameable(true))
       petType = HUNTER_PET;
   }
+
+  void OnPlayerAfterGuardianInitStatsForLevel(Player *player,
+                                              Guardian *guardian) override {
+    if (guardian->IsPet() && guardian->ToPet()->getPetType() == HUNTER_PET)
+      sNpcBeastMaster->OnPetInitialized(player);
+  }
 };
 
 // Rename and cancel commands for pet renaming
@@ -963,6 +1264,9 @@ public:
   static bool HandlePetnameCancelCommand(ChatHandler *handler,
                                          std::string_view args);
   static bool HandleBeastmasterCommand(ChatHandler *handler, const char *args);
+  static bool HandleBeastmasterCacheCommand(ChatHandler *handler);
+  static bool HandleBeastmasterStatsCommand(ChatHandler *handler);
+  static bool HandleBeastmasterStatsResetCommand(ChatHandler *handler);
 };
 
 // Define GetCommands outside the class body
@@ -972,19 +1276,24 @@ BeastMaster_CommandScript::GetCommands() const {
   static ChatCommandTable petnameTable = {
       {"rename", HandlePetnameRenameCommand, SEC_PLAYER, Console::No},
       {"cancel", HandlePetnameCancelCommand, SEC_PLAYER, Console::No}};
-  return {{"beastmaster", HandleBeastmasterCommand, SEC_PLAYER, Console::No},
-          {"petname", petnameTable}};
+  static ChatCommandTable statsTable = {
+      {"reset", HandleBeastmasterStatsResetCommand, SEC_GAMEMASTER,
+       Console::Yes},
+      {"", HandleBeastmasterStatsCommand, SEC_GAMEMASTER, Console::Yes}};
+  static ChatCommandTable beastmasterTable = {
+      {"cache", HandleBeastmasterCacheCommand, SEC_GAMEMASTER, Console::Yes},
+      {"stats", statsTable},
+      {"", HandleBeastmasterCommand, SEC_PLAYER, Console::No}};
+  return {{"beastmaster", beastmasterTable}, {"petname", petnameTable}};
 }
 
 // Implement the new handlers:
 bool BeastMaster_CommandScript::HandlePetnameRenameCommand(
     ChatHandler *handler, std::string_view args) {
   Player *player = handler->GetSession()->GetPlayer();
-  auto *expectRename =
-      player->CustomData.Get<BeastmasterBool>("BeastmasterExpectRename");
-  auto *renameEntry =
-      player->CustomData.Get<BeastmasterUInt32>("BeastmasterRenamePetEntry");
-  if (!expectRename || !expectRename->value || !renameEntry) {
+  BeastmasterPlayerState *state = GetPlayerState(player);
+  uint32 renameEntry = state ? state->GetPendingRename() : 0;
+  if (!renameEntry) {
     handler->PSendSysMessage("You are not renaming a pet right now. Use the "
                              "Beastmaster NPC to start renaming.");
     return true;
@@ -1001,36 +1310,42 @@ bool BeastMaster_CommandScript::HandlePetnameRenameCommand(
     return true;
   }
 
-  if (!IsValidPetName(newName) || IsProfane(newName)) {
+  bool valid;
+  {
+    BeastmasterTimer timer(METRIC_RENAME_VALIDATION);
+    valid = IsValidPetName(newName);
+    if (valid && IsProfane(newName)) {
+      BeastmasterMetrics::Increment(COUNTER_PROFANITY_REJECTIONS);
+      valid = false;
+    }
+  }
+  if (!valid) {
     handler->PSendSysMessage("Invalid or profane pet name. Please try again "
                              "with .petname rename <newname>.");
     return true;
   }
 
-  CharacterDatabase.Execute("UPDATE beastmaster_tamed_pets SET name = '{}' "
-                            "WHERE owner_guid = {} AND entry = {}",
-                            newName, player->GetGUID().GetCounter(),
-                            renameEntry->value);
+  sNpcBeastMaster->GetJournal().Rename(player->GetGUID().GetCounter(),
+                                       renameEntry, newName);
 
-  player->CustomData.Erase("BeastmasterExpectRename");
-  player->CustomData.Erase("BeastmasterRenamePetEntry");
+  // Patch the cache rather than re-querying: the UPDATE is still pending.
+  sNpcBeastMaster->RenameTrackedPetInCache(player, renameEntry, newName);
+
+  state->ClearPendingRename();
 
   handler->PSendSysMessage("Pet renamed to '{}'.", newName);
-  sNpcBeastMaster->ClearTrackedPetsCache(player);
   return true;
 }
 
 bool BeastMaster_CommandScript::HandlePetnameCancelCommand(
     ChatHandler *handler, std::string_view /*args*/) {
   Player *player = handler->GetSession()->GetPlayer();
-  auto *expectRename =
-      player->CustomData.Get<BeastmasterBool>("BeastmasterExpectRename");
-  if (!expectRename || !expectRename->value) {
+  BeastmasterPlayerState *state = GetPlayerState(player);
+  if (!state || !state->GetPendingRename()) {
     handler->PSendSysMessage("You are not renaming a pet right now.");
     return true;
   }
-  player->CustomData.Erase("BeastmasterExpectRename");
-  player->CustomData.Erase("BeastmasterRenamePetEntry");
+  state->ClearPendingRename();
   handler->PSendSysMessage("Pet renaming cancelled.");
   return true;
 }
@@ -1041,29 +1356,59 @@ bool BeastMaster_CommandScript::HandleBeastmasterCommand(
   if (!player)
     return false;
 
+  // Checked before the cooldown starts, so an early try costs nothing.
+  if (!sNpcBeastMaster->IsCatalogReady()) {
+    handler->PSendSysMessage(
+        "My beasts are still arriving. Come back shortly.");
+    return true;
+  }
+
   float x = player->GetPositionX();
   float y = player->GetPositionY();
   float z = player->GetPositionZ();
   float o = player->GetOrientation();
 
-  static std::unordered_map<uint64, time_t> lastSummonTime;
-  uint64 guid = player->GetGUID().GetRawValue();
-  time_t now = time(nullptr);
-  uint32 cooldown =
-      sConfigMgr->GetOption<uint32>("BeastMaster.SummonCooldown", 120);
-  if (lastSummonTime.count(guid) && now - lastSummonTime[guid] < cooldown) {
+  auto config = sNpcBeastMaster->GetConfig();
+  BeastmasterSummonPool &pool = sNpcBeastMaster->GetSummonPool();
+  if (config->summonPool) {
+    // Reusing a nearby beastmaster is free: no cooldown, no new creature.
+    if (Creature *nearby =
+            pool.FindNearby(player, config->summonPoolReuseRange)) {
+      nearby->Whisper("Over here! I can help you with your pets.",
+                      LANG_UNIVERSAL, player);
+      handler->PSendSysMessage("A Beastmaster is already nearby.");
+      return true;
+    }
+
+    switch (pool.CanSummon(player, config->summonPoolMaxPerMap,
+                           config->summonPoolMaxPerZone)) {
+    case BeastmasterSummonPool::SUMMON_MAP_FULL:
+    case BeastmasterSummonPool::SUMMON_ZONE_FULL:
+      handler->PSendSysMessage("Too many Beastmasters are already about in "
+                               "this area. Please try again later.");
+      return true;
+    default:
+      break;
+    }
+  }
+
+  if (uint32 remaining = sNpcBeastMaster->GetCooldowns().TryStart(
+          BEASTMASTER_COOLDOWN_SUMMON, player->GetGUID().GetRawValue(),
+          config->summonCooldown, time(nullptr))) {
+    BeastmasterMetrics::Increment(COUNTER_SUMMON_COOLDOWN_REJECTIONS);
     handler->PSendSysMessage(
         "You must wait {} seconds before summoning the Beastmaster again.",
-        cooldown - (now - lastSummonTime[guid]));
+        remaining);
     return true;
   }
-  lastSummonTime[guid] = now;
 
-  Creature *npc = player->SummonCreature(GetBeastmasterNpcEntry(), x, y, z, o,
+  Creature *npc = player->SummonCreature(config->npcEntry, x, y, z, o,
                                          TEMPSUMMON_TIMED_DESPAWN_OUT_OF_COMBAT,
                                          2 * MINUTE * IN_MILLISECONDS);
 
   if (npc) {
+    if (config->summonPool)
+      pool.Add(player, npc);
     handler->PSendSysMessage(
         "The Beastmaster has arrived and will remain for 2 minutes.");
   } else {
@@ -1073,26 +1418,111 @@ bool BeastMaster_CommandScript::HandleBeastmasterCommand(
   return true;
 }
 
+bool BeastMaster_CommandScript::HandleBeastmasterCacheCommand(
+    ChatHandler *handler) {
+  auto stats = sNpcBeastMaster->GetTrackedPetsCache().GetStats();
+  uint64 lookups = stats.hits + stats.misses;
+  handler->PSendSysMessage(
+      "Tracked pets cache: {} lists, {} / {} KiB used.", stats.lists,
+      stats.bytes / 1024, stats.budget / 1024);
+  handler->PSendSysMessage(
+      "{} hits, {} misses ({}% hit rate), {} evictions.", stats.hits,
+      stats.misses, lookups ? stats.hits * 100 / lookups : 0,
+      stats.evictions);
+  return true;
+}
+
+bool BeastMaster_CommandScript::HandleBeastmasterStatsCommand(
+    ChatHandler *handler) {
+  handler->PSendSysMessage(
+      "Beastmaster stats (instrumentation {}), times in microseconds:",
+      BeastmasterMetrics::IsEnabled() ? "on" : "off");
+  for (uint32 i = 0; i < MAX_METRICS; ++i) {
+    auto metric = BeastmasterMetric(i);
+    BeastmasterMetrics::Summary summary = BeastmasterMetrics::Collect(metric);
+    if (!summary.count)
+      continue;
+    handler->PSendSysMessage(
+        "{}: {} calls, avg {:.1f}, p50 {:.1f}, p99 {:.1f}, max {:.1f}",
+        BeastmasterMetrics::GetName(metric), summary.count,
+        summary.totalNanoseconds / 1000.0 / summary.count,
+        summary.p50 / 1000.0, summary.p99 / 1000.0, summary.max / 1000.0);
+  }
+
+  handler->PSendSysMessage(
+      "Adoptions: {} normal, {} exotic, {} rare, {} rare exotic. Refused: {} "
+      "summons on cooldown, {} profane names.",
+      BeastmasterMetrics::GetCount(COUNTER_ADOPTIONS_NORMAL),
+      BeastmasterMetrics::GetCount(COUNTER_ADOPTIONS_EXOTIC),
+      BeastmasterMetrics::GetCount(COUNTER_ADOPTIONS_RARE),
+      BeastmasterMetrics::GetCount(COUNTER_ADOPTIONS_RARE_EXOTIC),
+      BeastmasterMetrics::GetCount(COUNTER_SUMMON_COOLDOWN_REJECTIONS),
+      BeastmasterMetrics::GetCount(COUNTER_PROFANITY_REJECTIONS));
+
+  auto cache = sNpcBeastMaster->GetTrackedPetsCache().GetStats();
+  uint64 lookups = cache.hits + cache.misses;
+  handler->PSendSysMessage(
+      "Tracked pets cache: {} hits, {} misses ({}% hit rate), {} evictions.",
+      cache.hits, cache.misses, lookups ? cache.hits * 100 / lookups : 0,
+      cache.evictions);
+
+  auto catalog = sNpcBeastMaster->GetCatalog();
+  handler->PSendSysMessage("Catalog: {} pets, {} bytes{}.",
+                           catalog->GetSize(), catalog->GetMemoryUsage(),
+                           catalog->IsMapped() ? ", mapped from file" : "");
+  handler->PSendSysMessage("Journal: {} pending writes.",
+                           sNpcBeastMaster->GetJournal().GetPendingCount());
+
+  auto keeper = sNpcBeastMaster->GetHappinessKeeper().GetStats();
+  handler->PSendSysMessage(
+      "Happiness keeper: {} players, {} sweeps ({} us last, {} us max), {} "
+      "pets topped up.",
+      keeper.trackedPlayers, keeper.sweeps, keeper.lastSweepMicros,
+      keeper.maxSweepMicros, keeper.toppedUp);
+
+  for (uint32 i = 0; i < MAX_LOCK_SITES; ++i) {
+    auto site = BeastmasterLockSite(i);
+    BeastmasterLockStats const &lock = GetLockStats(site);
+    BeastmasterLockStats const &baseline = LockStatsBaseline[site];
+    handler->PSendSysMessage(
+        "Lock {}: {} contended waits, {:.2f} ms waited.",
+        GetLockSiteName(site), lock.contentions - baseline.contentions,
+        (lock.waitNanoseconds - baseline.waitNanoseconds) / 1e6);
+  }
+  return true;
+}
+
+bool BeastMaster_CommandScript::HandleBeastmasterStatsResetCommand(
+    ChatHandler *handler) {
+  BeastmasterMetrics::Reset();
+  for (uint32 i = 0; i < MAX_LOCK_SITES; ++i) {
+    BeastmasterLockStats const &lock = GetLockStats(BeastmasterLockSite(i));
+    LockStatsBaseline[i].contentions = lock.contentions.load();
+    LockStatsBaseline[i].waitNanoseconds = lock.waitNanoseconds.load();
+  }
+  handler->PSendSysMessage("Beastmaster stats reset.");
+  return true;
+}
+
 class BeastmasterLoginNotice_PlayerScript : public PlayerScript {
 public:
   BeastmasterLoginNotice_PlayerScript()
       : PlayerScript("BeastmasterLoginNotice_PlayerScript") {}
 
   void OnLogin(Player *player) {
-    if (!sConfigMgr->GetOption<bool>("BeastMaster.ShowLoginNotice", true))
+    auto config = sNpcBeastMaster->GetConfig();
+    if (!config->showLoginNotice)
       return;
 
-    if (!sConfigMgr->GetOption<bool>("BeastMaster.Enable", true))
+    if (!config->enabled)
       return;
 
     // Optionally restrict to hunters if config says so
-    if (sConfigMgr->GetOption<bool>("BeastMaster.HunterOnly", true) &&
-        player->getClass() != CLASS_HUNTER)
+    if (config->hunterOnly && player->getClass() != CLASS_HUNTER)
       return;
 
     ChatHandler ch(player->GetSession());
-    std::string msg =
-        sConfigMgr->GetOption<std::string>("BeastMaster.LoginMessage", "");
+    std::string const &msg = config->loginMessage;
     if (!msg.empty())
       ch.PSendSysMessage("%s", msg.c_str());
     else
@@ -1116,6 +1546,8 @@ void Addmod_npc_beastmasterScripts() {
   new BeastMaster_CreatureScript();
   new BeastMaster_WorldScript();
   new BeastMaster_PlayerScript();
-  LOG_INFO("module", "Beastmaster: Registered commands: .beastmaster, .petname "
+  new BeastMaster_AllMapScript();
+  LOG_INFO("module", "Beastmaster: Registered commands: .beastmaster, "
+                     ".beastmaster cache, .beastmaster stats, .petname "
                      "rename, .petname cancel");
 }
@@ -19,28 +19,34 @@
 #ifndef _NPC_BEAST_MASTER_H_
 #define _NPC_BEAST_MASTER_H_
 
+#include "BeastmasterCatalog.h"
+#include "BeastmasterConfig.h"
+#include "BeastmasterCooldowns.h"
+#include "BeastmasterExporter.h"
+#include "BeastmasterGossipMenu.h"
+#include "BeastmasterHappinessKeeper.h"
+#include "BeastmasterJournal.h"
+#include "BeastmasterMetrics.h"
+#include "BeastmasterProfanityFilter.h"
+#include "BeastmasterSnapshot.h"
+#include "BeastmasterSummonPool.h"
+#include "BeastmasterTrackedPages.h"
+#include "BeastmasterTrackedPetsCache.h"
 #include "Common.h"
-#include <algorithm> // For std::sort
+#include "DatabaseEnv.h"
+#include "ObjectGuid.h"
+#include <atomic>
+#include <array>
+#include <ctime>
+#include <future>
 #include <map>
 #include <mutex>
-#include <tuple>
 #include <unordered_map>
 #include <vector>
 
 class Player;
 class Creature;
-
-/**
- * PetInfo
- * Structure to hold information about pets.
- */
-struct PetInfo {
-  uint32 entry;
-  std::string name;
-  uint32 family;
-  std::string rarity;
-  uint32 icon; // e.g. "Ability_Hunter_Pet_Wolf"
-};
+class Map;
 
 /**
  * NpcBeastmaster
@@ -49,7 +55,7 @@ struct PetInfo {
  * cache.
  */
 class NpcBeastmaster {
-  NpcBeastmaster() = default;
+  NpcBeastmaster();
   ~NpcBeastmaster() = default;
 
   NpcBeastmaster(NpcBeastmaster const &) = delete;
@@ -64,17 +70,81 @@ public:
   static NpcBeastmaster *instance();
 
   /**
-   * Loads all configuration options and pets from JSON and config.
-   * Thread-safe for global pet lists.
+   * Loads all configuration options and starts loading the pet catalog in
+   * the background. Thread-safe for global pet lists.
    */
   void LoadSystem(bool reload = false);
 
+  /**
+   * Current configuration snapshot. Lock-free; keep the returned pointer for
+   * the whole call so a concurrent reload cannot change options mid-way.
+   */
+  BeastmasterSnapshot<BeastmasterConfig>::Ptr GetConfig() const {
+    return configSnapshot.Get();
+  }
+
+  /**
+   * False until the first catalog load has finished. Gossip and the
+   * .beastmaster command are turned away before that; reloads keep serving
+   * the previous catalog.
+   */
+  bool IsCatalogReady() const {
+    return catalogReady.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Current pet catalog snapshot. Lock-free; pointers obtained from it stay
+   * valid for as long as the returned snapshot is held.
+   */
+  BeastmasterSnapshot<BeastmasterCatalog>::Ptr GetCatalog() const {
+    return catalogSnapshot.Get();
+  }
+
+  // Duration in ms of the last successful catalog load or reload.
+  uint32 GetCatalogLoadTime() const {
+    return catalogLoadTime.load(std::memory_order_relaxed);
+  }
+
   // Gossip menu logic
   void ShowMainMenu(Player *player, Creature *creature);
   void GossipSelect(Player *player, Creature *creature, uint32 action);
 
-  // Player update logic (e.g., keep pet happy)
-  void PlayerUpdate(Player *player);
+  // Creates the player's state and prefetches their tracked pets.
+  void OnPlayerLogin(Player *player);
+  void OnPlayerLogout(Player *player);
+
+  // Pet happiness keeper hooks (see BeastmasterHappinessKeeper).
+  void OnPetInitialized(Player *player);
+  void UpdateMap(Map *map, uint32 diff);
+  void OnMapDestroyed(Map *map);
+
+  BeastmasterHappinessKeeper const &GetHappinessKeeper() const {
+    return happinessKeeper;
+  }
+
+  /**
+   * Current profanity filter, or null while none is loaded. Recompiled in
+   * the background when the word list file changes.
+   */
+  BeastmasterSnapshot<BeastmasterProfanityFilter>::Ptr
+  GetProfanityFilter() const {
+    return profanitySnapshot.Get();
+  }
+
+  // Per-player cooldowns of rate-limited actions.
+  BeastmasterCooldowns &GetCooldowns() { return cooldowns; }
+
+  // Beastmasters summoned with .beastmaster (see BeastmasterSummonPool).
+  BeastmasterSummonPool &GetSummonPool() { return summonPool; }
+
+  // Tracked pet writes (see BeastmasterJournal).
+  BeastmasterJournal &GetJournal() { return journal; }
+  void UpdateWorld(uint32 diff);
+  void OnShutdown();
+
+  BeastmasterTrackedPetsCache const &GetTrackedPetsCache() const {
+    return trackedPetsCache;
+  }
 
   /**
    * Clears the tracked pets cache for a specific player.
@@ -83,17 +153,89 @@ public:
   void ClearTrackedPetsCache(Player *player);
 
   /**
-   * Shows the tracked pets menu for the player, with pagination and actions.
+   * Patch a cached tracked pets list after a delete or rename, so the menu
+   * keeps serving from memory while the write is still queued.
+   * Thread-safe.
    */
-  void ShowTrackedPetsMenu(Player *player, Creature *creature, uint32 page = 1);
+  void RemoveTrackedPetFromCache(Player *player, uint32 entry);
+  void RenameTrackedPetInCache(Player *player, uint32 entry,
+                               std::string const &name);
+
+  /**
+   * Shows a page of the tracked pets menu, with actions and Previous/Next.
+   * Unless it is the page already cached, the page alone is queried
+   * asynchronously and the menu is sent when the result arrives, unless the
+   * player logged out, interacted with another menu or walked away in the
+   * meantime.
+   */
+  void ShowTrackedPetsMenu(Player *player, Creature *creature,
+                           BeastmasterTrackedPageQuery query = {});
 
 private:
+  // Starts the asynchronous load of the player's tracked pet entries.
+  void LoadPlayerState(Player *player);
+
+  // Gossip handlers, one per BeastmasterGossipOpcode; each gets the payload
+  // of the action.
+  using GossipHandler = void (NpcBeastmaster::*)(Player *, Creature *,
+                                                 uint32 payload);
+
+  struct GossipRoute {
+    BeastmasterGossipOpcode opcode;
+    GossipHandler handler;
+    BeastmasterMetric metric; // MAX_METRICS leaves the action untimed
+  };
+
+  // Indexed by opcode, so GossipSelect dispatches with a single lookup.
+  static std::array<GossipRoute, MAX_GOSSIP_OPCODES> const gossipRoutes;
+
+  void HandleNoAction(Player *player, Creature *creature, uint32 payload);
+  void HandleMainMenu(Player *player, Creature *creature, uint32 payload);
+  void HandleCatalogPage(Player *player, Creature *creature, uint32 payload);
+  void HandleRemoveSkills(Player *player, Creature *creature, uint32 payload);
+  void HandleStable(Player *player, Creature *creature, uint32 payload);
+  void HandleVendor(Player *player, Creature *creature, uint32 payload);
+  void HandleTrackedMenu(Player *player, Creature *creature, uint32 seek);
+  void HandleTrackedSummon(Player *player, Creature *creature, uint32 index);
+  void HandleTrackedRename(Player *player, Creature *creature, uint32 index);
+  void HandleTrackedDelete(Player *player, Creature *creature, uint32 index);
+
   // Handles pet creation/adoption for the player.
-  void CreatePet(Player *player, Creature *creature, uint32 action);
+  void CreatePet(Player *player, Creature *creature, uint32 petEntry);
+
+  // Sends a prebuilt catalog page with the player's tamed pets marked.
+  void SendCatalogPage(Player *player, Creature *creature,
+                       BeastmasterCatalog const &catalog,
+                       BeastmasterPetCategory category, uint32 page);
+
+  // Copies the cached tracked pets of the player; false on a cache miss.
+  bool GetTrackedPetsFromCache(Player *player, TrackedPetList &pets);
+
+  // Applies journaled writes that a query result may predate.
+  void ApplyPendingWrites(uint32 owner, std::vector<uint32> &entries) const;
+  void ApplyPendingWrites(uint32 owner,
+                          BeastmasterTrackedPageBuilder &page) const;
+
+  // Background task: maps the saved catalog or builds it from the database,
+  // then publishes it.
+  void LoadCatalog(BeastmasterConfig const &config);
+
+  // Queries and validates the tames; nullptr if the query fails.
+  std::shared_ptr<BeastmasterCatalog>
+  QueryCatalog(BeastmasterConfig const &config);
 
-  // Adds pets to the gossip menu for the given page.
-  void AddPetsToGossip(Player *player, std::vector<PetInfo> const &pets,
-                       uint32 page);
+  // Background task: recompiles the profanity filter if the file changed.
+  void ReloadProfanityFilter(BeastmasterConfig const &config, bool force);
+
+  // Async continuation of ShowTrackedPetsMenu.
+  void HandleTrackedPetsResult(ObjectGuid playerGuid, ObjectGuid creatureGuid,
+                               BeastmasterTrackedPageQuery query,
+                               uint32 menuToken, QueryResult result);
+
+  // Renders one page of tracked pets and sends the gossip menu.
+  void SendTrackedPetsPage(Player *player, Creature *creature,
+                           TrackedPetList const &trackedPets,
+                           BeastmasterTrackedPageInfo const &page);
 
   // Handles the rename prompt for pets.
   void HandleRenamePet(Player *player, Creature *creature, uint32 entry);
@@ -101,17 +243,29 @@ private:
   // Handles the delete confirmation for pets.
   void HandleDeletePet(Player *player, Creature *creature, uint32 entry);
 
-  // Sorts pets by name (utility).
-  void SortPetsByName(std::vector<PetInfo> &normalPets) {
-    std::sort(
-        normalPets.begin(), normalPets.end(),
-        [](const PetInfo &a, const PetInfo &b) { return a.name < b.name; });
-  }
+  BeastmasterSnapshot<BeastmasterConfig> configSnapshot;
+  std::atomic<uint32> configVersion{0};
+  BeastmasterSnapshot<BeastmasterCatalog> catalogSnapshot;
+  std::future<void> catalogLoad;
+  std::atomic<bool> catalogReady{false};
+  std::atomic<uint32> catalogLoadTime{0};
+
+  BeastmasterHappinessKeeper happinessKeeper;
+  BeastmasterJournal journal;
+  BeastmasterCooldowns cooldowns;
+  BeastmasterSummonPool summonPool;
+  std::atomic<uint32> playerStateToken{0};
+
+  // The tracked pets page each player last saw.
+  BeastmasterTrackedPetsCache trackedPetsCache;
+
+  BeastmasterSnapshot<BeastmasterProfanityFilter> profanitySnapshot;
+  std::future<void> profanityReload;
+  std::atomic<bool> profanityReloadRequested{false};
+  uint32 profanityCheckTimer = 0;
+  time_t profanityFileTime = 0; // Only used by the reload task
 
-  std::mutex trackedPetsCacheMutex;
-  std::unordered_map<uint64,
-                     std::vector<std::tuple<uint32, std::string, std::string>>>
-      trackedPetsCache;
+  BeastmasterExporter exporter;
 };
 
 #define sNpcBeastMaster NpcBeastmaster::instance()
@@ -0,0 +1,224 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterCatalog.h"
+#include <algorithm>
+
+void BeastmasterCatalog::Add(uint32 entry, std::string_view name,
+                             uint32 family, BeastmasterPetRarity rarity,
+                             uint32 icon, BeastmasterPetCategory category) {
+  name = name.substr(0, 255);
+
+  auto interned = _internedNames.find(std::string(name));
+  uint32 offset;
+  if (interned != _internedNames.end()) {
+    offset = interned->second;
+  } else {
+    offset = uint32(_names.size());
+    _names.append(name);
+    _internedNames.emplace(std::string(name), offset);
+  }
+
+  _entries.push_back(entry);
+  _families.push_back(uint16(family));
+  _rarities.push_back(rarity);
+  _icons.push_back(uint8(icon));
+  _categories.push_back(uint8(category));
+  _nameOffsets.push_back(offset);
+  _nameLengths.push_back(uint8(name.size()));
+}
+
+void BeastmasterCatalog::Finalize() {
+  // Counting sort of row indices by category keeps load order within each.
+  std::array<uint32, MAX_PET_CATEGORIES> counts = {};
+  for (uint8 category : _categories)
+    ++counts[category];
+
+  _categoryBegin[0] = 0;
+  for (uint32 i = 0; i < MAX_PET_CATEGORIES; ++i)
+    _categoryBegin[i + 1] = _categoryBegin[i] + counts[i];
+
+  _categoryRows.resize(_entries.size());
+  std::array<uint32, MAX_PET_CATEGORIES> next = {};
+  std::copy_n(_categoryBegin.begin(), MAX_PET_CATEGORIES, next.begin());
+  for (uint32 row = 0; row < _categories.size(); ++row)
+    _categoryRows[next[_categories[row]]++] = row;
+
+  BuildEntryIndex();
+
+  _internedNames.clear();
+  _categories.clear();
+
+  _entries.shrink_to_fit();
+  _families.shrink_to_fit();
+  _rarities.shrink_to_fit();
+  _icons.shrink_to_fit();
+  _categories.shrink_to_fit();
+  _nameOffsets.shrink_to_fit();
+  _nameLengths.shrink_to_fit();
+  _names.shrink_to_fit();
+
+  BindColumns();
+}
+
+void BeastmasterCatalog::BindColumns() {
+  _entryColumn = _entries;
+  _familyColumn = _families;
+  _rarityColumn = _rarities;
+  _iconColumn = _icons;
+  _nameOffsetColumn = _nameOffsets;
+  _nameLengthColumn = _nameLengths;
+  _nameArena = _names;
+  _categoryRowColumn = _categoryRows;
+  _displacementColumn = _displacements;
+  _slotEntryColumn = _slotEntries;
+  _slotRowColumn = _slotRows;
+}
+
+static uint32 NextPowerOfTwo(uint32 value) {
+  uint32 result = 1;
+  while (result < value)
+    result <<= 1;
+  return result;
+}
+
+void BeastmasterCatalog::BuildEntryIndex() {
+  // Entries are a primary key in the table, but guard against duplicates so
+  // the displacement search below always terminates.
+  std::vector<uint32> rows(_entries.size());
+  for (uint32 row = 0; row < rows.size(); ++row)
+    rows[row] = row;
+  std::stable_sort(rows.begin(), rows.end(), [this](uint32 a, uint32 b) {
+    return _entries[a] < _entries[b];
+  });
+  rows.erase(std::unique(rows.begin(), rows.end(),
+                         [this](uint32 a, uint32 b) {
+                           return _entries[a] == _entries[b];
+                         }),
+             rows.end());
+
+  uint32 count = uint32(rows.size());
+  if (!count)
+    return;
+
+  // About four keys per bucket and a load factor of at most 0.8 keep the
+  // build linear in practice; the table doubles if a bucket gets stuck.
+  uint32 bucketCount = NextPowerOfTwo(std::max<uint32>(1, count / 4));
+  uint32 slotCount = NextPowerOfTwo(count + count / 4);
+
+  std::vector<std::vector<uint32>> buckets;
+  for (;;) {
+    _bucketMask = bucketCount - 1;
+    _slotMask = slotCount - 1;
+    _displacements.assign(bucketCount, 0);
+    _slotEntries.assign(slotCount, NOT_FOUND);
+    _slotRows.assign(slotCount, NOT_FOUND);
+
+    buckets.assign(bucketCount, {});
+    for (uint32 row : rows)
+      buckets[uint32(HashEntry(_entries[row]) >> 32) & _bucketMask].push_back(
+          row);
+
+    // Place the largest buckets first while the table is still empty.
+    std::vector<uint32> order(bucketCount);
+    for (uint32 i = 0; i < bucketCount; ++i)
+      order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](uint32 a, uint32 b) {
+      return buckets[a].size() > buckets[b].size();
+    });
+
+    bool placedAll = true;
+    std::vector<uint32> slots;
+    for (uint32 bucket : order) {
+      if (buckets[bucket].empty())
+        break;
+
+      bool placed = false;
+      for (uint32 displacement = 0; displacement < 4 * slotCount;
+           ++displacement) {
+        slots.clear();
+        for (uint32 row : buckets[bucket]) {
+          uint32 slot = SlotOf(HashEntry(_entries[row]), displacement);
+          if (_slotEntries[slot] != NOT_FOUND ||
+              std::find(slots.begin(), slots.end(), slot) != slots.end())
+            break;
+          slots.push_back(slot);
+        }
+
+        if (slots.size() != buckets[bucket].size())
+          continue;
+
+        for (uint32 i = 0; i < slots.size(); ++i) {
+          _slotEntries[slots[i]] = _entries[buckets[bucket][i]];
+          _slotRows[slots[i]] = buckets[bucket][i];
+        }
+        _displacements[bucket] = displacement;
+        placed = true;
+        break;
+      }
+
+      if (!placed) {
+        placedAll = false;
+        break;
+      }
+    }
+
+    if (placedAll)
+      return;
+    slotCount <<= 1;
+  }
+}
+
+std::optional<PetInfo> BeastmasterCatalog::Find(uint32 entry) const {
+  uint32 row = FindRow(entry);
+  if (row == NOT_FOUND)
+    return std::nullopt;
+  return GetPet(row);
+}
+
+std::size_t BeastmasterCatalog::GetMemoryUsage() const {
+  return sizeof(*this) + _entries.capacity() * sizeof(uint32) +
+         _families.capacity() * sizeof(uint16) + _rarities.capacity() +
+         _icons.capacity() + _nameOffsets.capacity() * sizeof(uint32) +
+         _nameLengths.capacity() + _names.capacity() +
+         _categoryRows.capacity() * sizeof(uint32) +
+         _displacements.capacity() * sizeof(uint32) +
+         _slotEntries.capacity() * sizeof(uint32) +
+         _slotRows.capacity() * sizeof(uint32) + _mappingSize +
+         _gossipPages.GetMemoryUsage();
+}
+
+std::size_t BeastmasterCatalog::EstimateLegacyMemoryUsage() const {
+  // struct { uint32; std::string; uint32; std::string; uint32; }
+  std::size_t const record = 3 * sizeof(uint32) + 2 * sizeof(std::string);
+  // std::string keeps up to 15 characters inline (libstdc++ / MSVC).
+  std::size_t const inlineChars = 15;
+
+  std::size_t perCopy = 0;
+  for (uint8 length : _nameLengthColumn) {
+    perCopy += record;
+    if (length > inlineChars)
+      perCopy += length + 1;
+  }
+
+  // allPets, one category vector and allPetsByEntry each held a copy; the
+  // map adds a node header (key + next pointer) and a bucket per row.
+  std::size_t const mapOverhead =
+      GetSize() * (sizeof(uint32) + 2 * sizeof(void *));
+  return 3 * perCopy + mapOverhead;
+}
@@ -0,0 +1,205 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_CATALOG_H_
+#define _BEASTMASTER_CATALOG_H_
+
+#include "BeastmasterDefines.h"
+#include "BeastmasterGossipPages.h"
+#include <array>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+enum BeastmasterPetRarity : uint8 { PET_RARITY_NORMAL = 0, PET_RARITY_EXOTIC };
+
+enum BeastmasterPetCategory {
+  PET_CATEGORY_NORMAL = 0,
+  PET_CATEGORY_EXOTIC,
+  PET_CATEGORY_RARE,
+  PET_CATEGORY_RARE_EXOTIC,
+  MAX_PET_CATEGORIES
+};
+
+/**
+ * PetInfo
+ * Read-only view of one catalog row. The name points into the catalog's
+ * string arena and is only valid while the catalog snapshot is held.
+ */
+struct PetInfo {
+  uint32 entry;
+  std::string_view name;
+  uint32 family;
+  BeastmasterPetRarity rarity;
+  uint32 icon; // Gossip icon, trainer or vendor depending on family
+};
+
+/**
+ * BeastmasterCatalog
+ * The adoptable pets in a structure-of-arrays layout: one column per field,
+ * names interned in a single arena, and each category stored as a span of
+ * row indices rather than a copy of the rows.
+ *
+ * Built off to the side by LoadSystem and never modified once published, so
+ * readers holding a snapshot need no lock. The columns are read through
+ * spans, which point either at vectors owned by the catalog or straight into
+ * a mapped catalog file (see BeastmasterCatalogFile).
+ */
+class BeastmasterCatalog {
+public:
+  explicit BeastmasterCatalog(uint32 version = 0) : _version(version) {}
+
+  // The column views would point into the source.
+  BeastmasterCatalog(BeastmasterCatalog const &) = delete;
+  BeastmasterCatalog &operator=(BeastmasterCatalog const &) = delete;
+
+  // Distinguishes snapshots, e.g. for data derived from row indices.
+  uint32 GetVersion() const { return _version; }
+
+  void Add(uint32 entry, std::string_view name, uint32 family,
+           BeastmasterPetRarity rarity, uint32 icon,
+           BeastmasterPetCategory category);
+
+  // Groups rows by category and drops build-only state. Call once, last.
+  void Finalize();
+
+  std::optional<PetInfo> Find(uint32 entry) const;
+
+  // Row of the given entry, or NOT_FOUND. Two probes into flat arrays.
+  uint32 FindRow(uint32 entry) const {
+    if (_slotEntryColumn.empty())
+      return NOT_FOUND;
+    uint64 hash = HashEntry(entry);
+    uint32 bucket = uint32(hash >> 32) & _bucketMask;
+    uint32 slot = SlotOf(hash, _displacementColumn[bucket]);
+    return _slotEntryColumn[slot] == entry ? _slotRowColumn[slot] : NOT_FOUND;
+  }
+
+  static constexpr uint32 NOT_FOUND = ~uint32(0);
+
+  PetInfo GetPet(uint32 row) const {
+    return {_entryColumn[row], GetName(row), _familyColumn[row],
+            BeastmasterPetRarity(_rarityColumn[row]), _iconColumn[row]};
+  }
+
+  std::string_view GetName(uint32 row) const {
+    return _nameArena.substr(_nameOffsetColumn[row], _nameLengthColumn[row]);
+  }
+
+  // Row indices of the given category, in load order.
+  std::span<uint32 const> GetCategory(BeastmasterPetCategory category) const {
+    return _categoryRowColumn.subspan(_categoryBegin[category],
+                                      _categoryBegin[category + 1] -
+                                          _categoryBegin[category]);
+  }
+
+  std::size_t GetSize() const { return _entryColumn.size(); }
+
+  // Bytes held by this catalog, including container slack and the mapped
+  // file, if any.
+  std::size_t GetMemoryUsage() const;
+
+  // True if the columns live in a mapped catalog file.
+  bool IsMapped() const { return _mapping != nullptr; }
+
+  // What the same rows cost in the previous three-copy PetInfo layout.
+  std::size_t EstimateLegacyMemoryUsage() const;
+
+  // Prebuilt browse menus, rendered by the loader before publishing.
+  BeastmasterGossipPages const &GetGossipPages() const { return _gossipPages; }
+  void SetGossipPages(BeastmasterGossipPages pages) {
+    _gossipPages = std::move(pages);
+  }
+
+  static std::string_view GetRarityName(BeastmasterPetRarity rarity) {
+    return rarity == PET_RARITY_EXOTIC ? "exotic" : "normal";
+  }
+
+private:
+  friend class BeastmasterCatalogFile;
+
+  // Points the column views at the owned vectors.
+  void BindColumns();
+
+  uint32 _version;
+
+  // Columns as read by every accessor.
+  std::span<uint32 const> _entryColumn;
+  std::span<uint16 const> _familyColumn;
+  std::span<uint8 const> _rarityColumn;
+  std::span<uint8 const> _iconColumn;
+  std::span<uint32 const> _nameOffsetColumn;
+  std::span<uint8 const> _nameLengthColumn;
+  std::string_view _nameArena;
+  std::span<uint32 const> _categoryRowColumn;
+  std::span<uint32 const> _displacementColumn;
+  std::span<uint32 const> _slotEntryColumn;
+  std::span<uint32 const> _slotRowColumn;
+
+  // Keeps a mapped file alive while the views point into it.
+  std::shared_ptr<void const> _mapping;
+  std::size_t _mappingSize = 0;
+
+  // Owned storage of a catalog built by Add() and Finalize().
+  std::vector<uint32> _entries;
+  std::vector<uint16> _families;
+  std::vector<uint8> _rarities;
+  std::vector<uint8> _icons;
+  std::vector<uint8> _categories;
+  std::vector<uint32> _nameOffsets;
+  std::vector<uint8> _nameLengths;
+  std::string _names;
+
+  std::vector<uint32> _categoryRows;
+  std::array<uint32, MAX_PET_CATEGORIES + 1> _categoryBegin = {};
+
+  static uint64 HashEntry(uint32 entry) {
+    return (uint64(entry) + 1) * 0x9E3779B97F4A7C15ull;
+  }
+
+  uint32 SlotOf(uint64 hash, uint32 displacement) const {
+    uint64 x = hash + uint64(displacement) * 0xC2B2AE3D27D4EB4Full;
+    x ^= x >> 31;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 29;
+    return uint32(x) & _slotMask;
+  }
+
+  // Builds the perfect hash index over _entries.
+  void BuildEntryIndex();
+
+  // Entry index: a perfect hash built once per snapshot. Each bucket stores
+  // the displacement that sends all of its entries to distinct free slots,
+  // so a lookup never probes more than one slot.
+  std::vector<uint32> _displacements;
+  std::vector<uint32> _slotEntries;
+  std::vector<uint32> _slotRows;
+  uint32 _bucketMask = 0;
+  uint32 _slotMask = 0;
+
+  BeastmasterGossipPages _gossipPages;
+
+  // Build-only: name -> arena offset, so repeated names are stored once.
+  std::unordered_map<std::string, uint32> _internedNames;
+};
+
+#endif // _BEASTMASTER_CATALOG_H_
@@ -0,0 +1,301 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterCatalogFile.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr char FILE_MAGIC[8] = {'B', 'M', 'C', 'A', 'T', 'A', 'L', 'G'};
+// Reads back differently on a machine of the other byte order.
+constexpr uint32 BYTE_ORDER_MARK = 0x01020304;
+
+struct FileHeader {
+  char magic[8];
+  uint32 formatVersion;
+  uint32 byteOrder;
+  uint64 payloadSize;
+  uint64 checksum; // Hash of the payload
+  BeastmasterCatalogKey key;
+  uint32 rowCount;
+  uint32 nameBytes;
+  uint32 bucketCount;
+  uint32 slotCount;
+  uint32 categoryBegin[MAX_PET_CATEGORIES + 1];
+  uint32 padding;
+};
+
+static_assert(std::is_trivially_copyable_v<FileHeader>);
+static_assert(sizeof(FileHeader) % 8 == 0,
+              "the payload must start 8-byte aligned");
+
+// Payload offset of every column. Each starts 8-byte aligned, so a mapped
+// file (page aligned) can be viewed in place.
+struct Layout {
+  std::size_t entries, nameOffsets, categoryRows, displacements, slotEntries,
+      slotRows, families, nameLengths, rarities, icons, names, size = 0;
+
+  explicit Layout(FileHeader const &header) {
+    auto take = [this](std::size_t bytes) {
+      std::size_t offset = size;
+      size = (size + bytes + 7) & ~std::size_t(7);
+      return offset;
+    };
+    std::size_t rows = header.rowCount;
+    entries = take(rows * sizeof(uint32));
+    nameOffsets = take(rows * sizeof(uint32));
+    categoryRows = take(rows * sizeof(uint32));
+    displacements = take(std::size_t(header.bucketCount) * sizeof(uint32));
+    slotEntries = take(std::size_t(header.slotCount) * sizeof(uint32));
+    slotRows = take(std::size_t(header.slotCount) * sizeof(uint32));
+    families = take(rows * sizeof(uint16));
+    nameLengths = take(rows);
+    rarities = take(rows);
+    icons = take(rows);
+    names = take(header.nameBytes);
+  }
+};
+
+struct MappedFile {
+  std::shared_ptr<void const> owner;
+  std::span<std::byte const> data;
+};
+
+#ifdef _WIN32
+// No mapping here; the file is read into memory instead.
+bool MapFile(std::string const &path, MappedFile &mapped, std::string &error) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    error = "cannot open file";
+    return false;
+  }
+
+  file.seekg(0, std::ios::end);
+  auto buffer = std::make_shared<std::vector<std::byte>>(
+      std::size_t(file.tellg()));
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char *>(buffer->data()),
+                 std::streamsize(buffer->size()))) {
+    error = "cannot read file";
+    return false;
+  }
+
+  mapped.data = *buffer;
+  mapped.owner = std::move(buffer);
+  return true;
+}
+#else
+bool MapFile(std::string const &path, MappedFile &mapped, std::string &error) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    error = std::strerror(errno);
+    return false;
+  }
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+    close(fd);
+    error = "cannot stat file or file is empty";
+    return false;
+  }
+
+  std::size_t size = std::size_t(fileStat.st_size);
+  void *address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (address == MAP_FAILED) {
+    error = std::strerror(errno);
+    return false;
+  }
+
+  mapped.data = {static_cast<std::byte const *>(address), size};
+  mapped.owner = std::shared_ptr<void const>(
+      address, [size](void const *p) { munmap(const_cast<void *>(p), size); });
+  return true;
+}
+#endif
+
+template <typename T>
+std::span<T const> View(std::span<std::byte const> payload, std::size_t offset,
+                        std::size_t count) {
+  return {reinterpret_cast<T const *>(payload.data() + offset), count};
+}
+
+template <typename T>
+void Put(std::vector<std::byte> &payload, std::size_t offset,
+         std::span<T const> column) {
+  if (!column.empty())
+    std::memcpy(payload.data() + offset, column.data(), column.size_bytes());
+}
+} // namespace
+
+/*static*/ uint64 BeastmasterCatalogFile::Hash(std::span<std::byte const> data,
+                                               uint64 hash) {
+  for (std::byte b : data) {
+    hash ^= uint64(b);
+    hash *= 0x100000001B3ull;
+  }
+  return hash;
+}
+
+/*static*/ bool
+BeastmasterCatalogFile::Write(std::string const &path,
+                              BeastmasterCatalog const &catalog,
+                              BeastmasterCatalogKey const &key) {
+  FileHeader header = {};
+  std::copy(std::begin(FILE_MAGIC), std::end(FILE_MAGIC), header.magic);
+  header.formatVersion = FORMAT_VERSION;
+  header.byteOrder = BYTE_ORDER_MARK;
+  header.key = key;
+  header.rowCount = uint32(catalog.GetSize());
+  header.nameBytes = uint32(catalog._nameArena.size());
+  header.bucketCount = uint32(catalog._displacementColumn.size());
+  header.slotCount = uint32(catalog._slotEntryColumn.size());
+  std::copy(catalog._categoryBegin.begin(), catalog._categoryBegin.end(),
+            header.categoryBegin);
+
+  Layout layout(header);
+  std::vector<std::byte> payload(layout.size);
+  Put(payload, layout.entries, catalog._entryColumn);
+  Put(payload, layout.nameOffsets, catalog._nameOffsetColumn);
+  Put(payload, layout.categoryRows, catalog._categoryRowColumn);
+  Put(payload, layout.displacements, catalog._displacementColumn);
+  Put(payload, layout.slotEntries, catalog._slotEntryColumn);
+  Put(payload, layout.slotRows, catalog._slotRowColumn);
+  Put(payload, layout.families, catalog._familyColumn);
+  Put(payload, layout.nameLengths, catalog._nameLengthColumn);
+  Put(payload, layout.rarities, catalog._rarityColumn);
+  Put(payload, layout.icons, catalog._iconColumn);
+  Put(payload, layout.names, std::span<char const>(catalog._nameArena));
+
+  header.payloadSize = payload.size();
+  header.checksum = Hash(payload);
+
+  std::string temp = path + ".tmp";
+  std::error_code ec;
+  {
+    std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<char const *>(&header), sizeof(header));
+    file.write(reinterpret_cast<char const *>(payload.data()),
+               std::streamsize(payload.size()));
+    if (!file.good()) {
+      file.close();
+      std::filesystem::remove(temp, ec);
+      return false;
+    }
+  }
+
+  std::filesystem::rename(temp, path, ec);
+  if (ec) {
+    std::filesystem::remove(temp, ec);
+    return false;
+  }
+  return true;
+}
+
+/*static*/ std::shared_ptr<BeastmasterCatalog>
+BeastmasterCatalogFile::Read(std::string const &path,
+                             BeastmasterCatalogKey const &key, uint32 version,
+                             std::string &error) {
+  MappedFile mapped;
+  if (!MapFile(path, mapped, error))
+    return nullptr;
+
+  FileHeader header;
+  if (mapped.data.size() < sizeof(header)) {
+    error = "file is truncated";
+    return nullptr;
+  }
+  std::memcpy(&header, mapped.data.data(), sizeof(header));
+
+  if (!std::equal(std::begin(FILE_MAGIC), std::end(FILE_MAGIC),
+                  header.magic)) {
+    error = "not a catalog file";
+    return nullptr;
+  }
+  if (header.formatVersion != FORMAT_VERSION ||
+      header.byteOrder != BYTE_ORDER_MARK) {
+    error = "written by another version or platform";
+    return nullptr;
+  }
+  if (header.key != key) {
+    error = "beastmaster_tames or the rare pet options changed";
+    return nullptr;
+  }
+
+  Layout layout(header);
+  std::span<std::byte const> payload = mapped.data.subspan(sizeof(header));
+  if (header.payloadSize != layout.size || payload.size() != layout.size) {
+    error = "file size does not match its header";
+    return nullptr;
+  }
+  if (Hash(payload) != header.checksum) {
+    error = "checksum mismatch";
+    return nullptr;
+  }
+
+  // Invariants the lookups rely on; the checksum only covers corruption.
+  auto isPowerOfTwoOrZero = [](uint32 n) { return (n & (n - 1)) == 0; };
+  if (!isPowerOfTwoOrZero(header.bucketCount) ||
+      !isPowerOfTwoOrZero(header.slotCount) ||
+      !std::is_sorted(std::begin(header.categoryBegin),
+                      std::end(header.categoryBegin)) ||
+      header.categoryBegin[MAX_PET_CATEGORIES] != header.rowCount) {
+    error = "inconsistent index";
+    return nullptr;
+  }
+
+  auto catalog = std::make_shared<BeastmasterCatalog>(version);
+  uint32 rows = header.rowCount;
+  catalog->_entryColumn = View<uint32>(payload, layout.entries, rows);
+  catalog->_nameOffsetColumn = View<uint32>(payload, layout.nameOffsets, rows);
+  catalog->_categoryRowColumn =
+      View<uint32>(payload, layout.categoryRows, rows);
+  catalog->_displacementColumn =
+      View<uint32>(payload, layout.displacements, header.bucketCount);
+  catalog->_slotEntryColumn =
+      View<uint32>(payload, layout.slotEntries, header.slotCount);
+  catalog->_slotRowColumn =
+      View<uint32>(payload, layout.slotRows, header.slotCount);
+  catalog->_familyColumn = View<uint16>(payload, layout.families, rows);
+  catalog->_nameLengthColumn = View<uint8>(payload, layout.nameLengths, rows);
+  catalog->_rarityColumn = View<uint8>(payload, layout.rarities, rows);
+  catalog->_iconColumn = View<uint8>(payload, layout.icons, rows);
+  auto names = View<char>(payload, layout.names, header.nameBytes);
+  catalog->_nameArena = std::string_view(names.data(), names.size());
+
+  std::copy(std::begin(header.categoryBegin), std::end(header.categoryBegin),
+            catalog->_categoryBegin.begin());
+  catalog->_bucketMask = header.bucketCount ? header.bucketCount - 1 : 0;
+  catalog->_slotMask = header.slotCount ? header.slotCount - 1 : 0;
+
+  catalog->_mappingSize = mapped.data.size();
+  catalog->_mapping = std::move(mapped.owner);
+  return catalog;
+}
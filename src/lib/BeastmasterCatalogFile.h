@@ -0,0 +1,80 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_CATALOG_FILE_H_
+#define _BEASTMASTER_CATALOG_FILE_H_
+
+#include "BeastmasterCatalog.h"
+#include "BeastmasterDefines.h"
+#include <memory>
+#include <span>
+#include <string>
+
+/**
+ * BeastmasterCatalogKey
+ * What a catalog was built from: the beastmaster_tames content (row count
+ * and two order-independent CRC aggregates, computed by the database) and a
+ * hash of the options that affect classification.
+ */
+struct BeastmasterCatalogKey {
+  uint64 rowCount = 0;
+  uint64 crcSum = 0;
+  uint64 crcXor = 0;
+  uint64 optionsHash = 0;
+
+  bool operator==(BeastmasterCatalogKey const &) const = default;
+};
+
+/**
+ * BeastmasterCatalogFile
+ * Saves a finalized catalog as a binary file and maps it back in on the next
+ * start: the columns, name arena, category index and entry index are stored
+ * exactly as the catalog holds them, so loading is a map and a checksum
+ * rather than a query.
+ *
+ * A file is only used if its format version, checksum and key all match;
+ * anything else means the caller should load from the database.
+ */
+class BeastmasterCatalogFile {
+public:
+  // Bump whenever the layout or the rules the catalog is built by change.
+  // 2: entries above MAX_ADOPT_ENTRY are left out.
+  static constexpr uint32 FORMAT_VERSION = 2;
+
+  /**
+   * Writes the catalog next to the path and renames it into place, so a
+   * crash never leaves a partial file behind. False on I/O errors.
+   */
+  static bool Write(std::string const &path, BeastmasterCatalog const &catalog,
+                    BeastmasterCatalogKey const &key);
+
+  /**
+   * Maps the file and returns a catalog whose columns point into it, or
+   * nullptr with the reason in error. Gossip pages are not stored; build
+   * them before publishing.
+   */
+  static std::shared_ptr<BeastmasterCatalog>
+  Read(std::string const &path, BeastmasterCatalogKey const &key,
+       uint32 version, std::string &error);
+
+  // 64-bit FNV-1a, chainable through the seed.
+  static uint64 Hash(std::span<std::byte const> data,
+                     uint64 hash = 0xCBF29CE484222325ull);
+};
+
+#endif // _BEASTMASTER_CATALOG_FILE_H_
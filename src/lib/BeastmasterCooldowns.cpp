@@ -0,0 +1,77 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterCooldowns.h"
+
+uint32 BeastmasterCooldowns::TryStart(BeastmasterCooldownAction action,
+                                      uint64 guid, uint32 seconds,
+                                      time_t now) {
+  if (!seconds)
+    return 0;
+
+  ActionCooldowns &cooldowns = _actions[action];
+  std::lock_guard<BeastmasterMutex> lock(cooldowns.lock);
+  Expire(cooldowns, now);
+
+  time_t expiry = now + seconds;
+  auto [it, started] = cooldowns.expiries.try_emplace(guid, expiry);
+  if (!started)
+    return uint32(it->second - now);
+
+  cooldowns.buckets[expiry].push_back(guid);
+  return 0;
+}
+
+uint32 BeastmasterCooldowns::GetRemaining(BeastmasterCooldownAction action,
+                                          uint64 guid, time_t now) {
+  ActionCooldowns &cooldowns = _actions[action];
+  std::lock_guard<BeastmasterMutex> lock(cooldowns.lock);
+  Expire(cooldowns, now);
+
+  auto it = cooldowns.expiries.find(guid);
+  return it != cooldowns.expiries.end() ? uint32(it->second - now) : 0;
+}
+
+void BeastmasterCooldowns::Clear(BeastmasterCooldownAction action,
+                                 uint64 guid) {
+  // The bucket keeps the guid until it expires; Expire() skips it then
+  // unless the player is on a new cooldown ending in the same second.
+  ActionCooldowns &cooldowns = _actions[action];
+  std::lock_guard<BeastmasterMutex> lock(cooldowns.lock);
+  cooldowns.expiries.erase(guid);
+}
+
+std::size_t
+BeastmasterCooldowns::GetSize(BeastmasterCooldownAction action) const {
+  ActionCooldowns const &cooldowns = _actions[action];
+  std::lock_guard<BeastmasterMutex> lock(cooldowns.lock);
+  return cooldowns.expiries.size();
+}
+
+/*static*/ void BeastmasterCooldowns::Expire(ActionCooldowns &cooldowns,
+                                             time_t now) {
+  auto end = cooldowns.buckets.upper_bound(now);
+  for (auto bucket = cooldowns.buckets.begin(); bucket != end; ++bucket) {
+    for (uint64 guid : bucket->second) {
+      auto it = cooldowns.expiries.find(guid);
+      if (it != cooldowns.expiries.end() && it->second <= now)
+        cooldowns.expiries.erase(it);
+    }
+  }
+  cooldowns.buckets.erase(cooldowns.buckets.begin(), end);
+}
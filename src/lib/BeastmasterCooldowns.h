@@ -0,0 +1,76 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_COOLDOWNS_H_
+#define _BEASTMASTER_COOLDOWNS_H_
+
+#include "BeastmasterDefines.h"
+#include "BeastmasterMutex.h"
+#include <array>
+#include <ctime>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+// Rate-limited actions; each has its own independent set of cooldowns.
+enum BeastmasterCooldownAction {
+  BEASTMASTER_COOLDOWN_SUMMON = 0, // .beastmaster
+  MAX_BEASTMASTER_COOLDOWNS
+};
+
+/**
+ * BeastmasterCooldowns
+ * Per-player cooldowns for rate-limited actions.
+ *
+ * Each action keeps the expiry time of every player on cooldown, plus the
+ * same players grouped in one bucket per expiry second. Every call first
+ * drops the buckets that have expired, so memory is bounded by the players
+ * currently on cooldown. Thread-safe; actions do not share a lock.
+ */
+class BeastmasterCooldowns {
+public:
+  /**
+   * Starts the cooldown unless it is already running. Returns 0 if it was
+   * started (or the duration is 0), else the seconds left.
+   */
+  uint32 TryStart(BeastmasterCooldownAction action, uint64 guid,
+                  uint32 seconds, time_t now);
+
+  // Seconds left on the cooldown, 0 if none.
+  uint32 GetRemaining(BeastmasterCooldownAction action, uint64 guid,
+                      time_t now);
+
+  void Clear(BeastmasterCooldownAction action, uint64 guid);
+
+  // Players currently on cooldown for the action.
+  std::size_t GetSize(BeastmasterCooldownAction action) const;
+
+private:
+  struct ActionCooldowns {
+    mutable BeastmasterMutex lock{LOCK_SITE_COOLDOWNS};
+    std::unordered_map<uint64, time_t> expiries;
+    std::map<time_t, std::vector<uint64>> buckets;
+  };
+
+  // Drops every cooldown that has expired by now. Lock held.
+  static void Expire(ActionCooldowns &cooldowns, time_t now);
+
+  std::array<ActionCooldowns, MAX_BEASTMASTER_COOLDOWNS> _actions;
+};
+
+#endif // _BEASTMASTER_COOLDOWNS_H_
@@ -0,0 +1,107 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterGossipMenu.h"
+
+namespace {
+// Every opcode byte, with the payloads at the edges of the range: a known
+// opcode decodes to itself, anything else to GOSSIP_OPCODE_NONE, and the
+// payload comes back untouched either way. The decoding is plain bit
+// slicing, so that covers every uint32 a client can send.
+constexpr bool CheckGossipActionDecoding() {
+  constexpr uint32 payloads[] = {0, 1, GOSSIP_PAYLOAD_MASK >> 1,
+                                 GOSSIP_PAYLOAD_MASK};
+  for (uint32 opcode = 0; opcode <= 0xFF; ++opcode) {
+    for (uint32 payload : payloads) {
+      uint32 action = (opcode << GOSSIP_OPCODE_SHIFT) | payload;
+      auto expected = opcode < MAX_GOSSIP_OPCODES
+                          ? BeastmasterGossipOpcode(opcode)
+                          : GOSSIP_OPCODE_NONE;
+      if (GetGossipOpcode(action) != expected ||
+          GetGossipPayload(action) != payload)
+        return false;
+      if (opcode < MAX_GOSSIP_OPCODES &&
+          EncodeGossipAction(expected, payload) != action)
+        return false;
+    }
+  }
+  return true;
+}
+
+constexpr bool CheckCatalogPageActions() {
+  for (uint32 index = 0; index < MAX_PET_CATEGORIES; ++index) {
+    for (uint32 page : {1u, 2u, 100u, 101u, (1u << GOSSIP_PAGE_BITS) - 1}) {
+      uint32 action =
+          EncodeCatalogPageAction(BeastmasterPetCategory(index), page);
+      BeastmasterPetCategory category{};
+      uint32 decodedPage = 0;
+      if (GetGossipOpcode(action) != GOSSIP_OPCODE_CATALOG_PAGE ||
+          !DecodeCatalogPagePayload(GetGossipPayload(action), category,
+                                    decodedPage) ||
+          category != index || decodedPage != page)
+        return false;
+    }
+  }
+  BeastmasterPetCategory category{};
+  uint32 page = 0;
+  return !DecodeCatalogPagePayload(0, category, page) &&
+         !DecodeCatalogPagePayload((MAX_PET_CATEGORIES << GOSSIP_PAGE_BITS) | 1,
+                                   category, page);
+}
+
+static_assert(CheckGossipActionDecoding());
+static_assert(CheckCatalogPageActions());
+static_assert(GetGossipPayload(EncodeAdoptAction(MAX_ADOPT_ENTRY)) ==
+              MAX_ADOPT_ENTRY);
+static_assert(EncodeGossipAction(GOSSIP_OPCODE_NONE) == 0,
+              "gossip items without an action send 0");
+} // namespace
+
+BeastmasterGossipPages BuildCatalogPages(BeastmasterCatalog const &catalog,
+                                         BeastmasterMenuIcons icons) {
+  BeastmasterGossipPages pages;
+  for (uint32 index = 0; index < MAX_PET_CATEGORIES; ++index) {
+    auto category = BeastmasterPetCategory(index);
+    auto rows = catalog.GetCategory(category);
+    uint32 pageCount = GetPageCount(rows.size(), PET_PAGE_SIZE);
+
+    for (uint32 page = 1; page <= pageCount; ++page) {
+      pages.AddPage(category);
+      pages.AddItem({icons.back, EncodeGossipAction(GOSSIP_OPCODE_MAIN_MENU),
+                     BeastmasterGossipItem::NO_ROW, "Back..", {}});
+      if (page > 1)
+        pages.AddItem({icons.navigation,
+                       EncodeCatalogPageAction(category, page - 1),
+                       BeastmasterGossipItem::NO_ROW, "Previous..", {}});
+      if (page < pageCount)
+        pages.AddItem({icons.navigation,
+                       EncodeCatalogPageAction(category, page + 1),
+                       BeastmasterGossipItem::NO_ROW, "Next..", {}});
+
+      BeastmasterPageSlice slice =
+          GetPageSlice(rows.size(), page, PET_PAGE_SIZE);
+      for (uint32 row : rows.subspan(slice.first, slice.count)) {
+        PetInfo pet = catalog.GetPet(row);
+        std::string name(pet.name);
+        pages.AddItem({pet.icon, EncodeAdoptAction(pet.entry), row, name,
+                       name + " (Already Tamed)"});
+      }
+    }
+  }
+  return pages;
+}
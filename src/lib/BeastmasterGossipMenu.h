@@ -0,0 +1,131 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_GOSSIP_MENU_H_
+#define _BEASTMASTER_GOSSIP_MENU_H_
+
+#include "BeastmasterCatalog.h"
+#include "BeastmasterDefines.h"
+#include "BeastmasterGossipPages.h"
+#include <algorithm>
+
+// What a gossip action asks for. The action carries the opcode in its high
+// byte and a payload in the low 24 bits, so every value decodes to exactly
+// one opcode and the payloads of different opcodes cannot collide.
+enum BeastmasterGossipOpcode : uint8 {
+  GOSSIP_OPCODE_NONE,           // Inert item, e.g. an already tamed pet
+  GOSSIP_OPCODE_MAIN_MENU,
+  GOSSIP_OPCODE_CATALOG_PAGE,   // Category << 16 | 1-based page
+  GOSSIP_OPCODE_ADOPT,          // Creature entry
+  GOSSIP_OPCODE_REMOVE_SKILLS,
+  GOSSIP_OPCODE_STABLE,
+  GOSSIP_OPCODE_VENDOR,
+  GOSSIP_OPCODE_TRACKED_MENU,   // Which way to page (BeastmasterTrackedSeek)
+  GOSSIP_OPCODE_TRACKED_SUMMON, // Index on the tracked pets page
+  GOSSIP_OPCODE_TRACKED_RENAME, // Index on the tracked pets page
+  GOSSIP_OPCODE_TRACKED_DELETE, // Index on the tracked pets page
+  MAX_GOSSIP_OPCODES
+};
+
+constexpr uint32 GOSSIP_OPCODE_SHIFT = 24;
+constexpr uint32 GOSSIP_PAYLOAD_MASK = (1u << GOSSIP_OPCODE_SHIFT) - 1;
+constexpr uint32 GOSSIP_PAGE_BITS = 16;
+
+// Highest creature entry an adopt action can carry; the catalog skips tames
+// above it.
+constexpr uint32 MAX_ADOPT_ENTRY = GOSSIP_PAYLOAD_MASK;
+
+constexpr uint32 PET_PAGE_SIZE = 13;
+constexpr uint32 PET_TRACKED_PAGE_SIZE = 10;
+
+constexpr uint32 EncodeGossipAction(BeastmasterGossipOpcode opcode,
+                                    uint32 payload = 0) {
+  return (uint32(opcode) << GOSSIP_OPCODE_SHIFT) |
+         (payload & GOSSIP_PAYLOAD_MASK);
+}
+
+// Unknown opcodes, whatever a client sends back, decode as
+// GOSSIP_OPCODE_NONE.
+constexpr BeastmasterGossipOpcode GetGossipOpcode(uint32 action) {
+  uint32 opcode = action >> GOSSIP_OPCODE_SHIFT;
+  return opcode < MAX_GOSSIP_OPCODES ? BeastmasterGossipOpcode(opcode)
+                                     : GOSSIP_OPCODE_NONE;
+}
+
+constexpr uint32 GetGossipPayload(uint32 action) {
+  return action & GOSSIP_PAYLOAD_MASK;
+}
+
+// Items [first, first + count) of a list shown a page at a time.
+struct BeastmasterPageSlice {
+  std::size_t first;
+  std::size_t count;
+};
+
+// Pages needed to show the items; an empty list still has one page.
+constexpr uint32 GetPageCount(std::size_t items, uint32 pageSize) {
+  return std::max<uint32>(1, uint32((items + pageSize - 1) / pageSize));
+}
+
+// The items on a 1-based page, clamped to the list.
+constexpr BeastmasterPageSlice GetPageSlice(std::size_t items, uint32 page,
+                                            uint32 pageSize) {
+  std::size_t first =
+      std::min(items, std::size_t(page ? page - 1 : 0) * pageSize);
+  return {first, std::min<std::size_t>(pageSize, items - first)};
+}
+
+constexpr uint32 EncodeCatalogPageAction(BeastmasterPetCategory category,
+                                         uint32 page) {
+  return EncodeGossipAction(GOSSIP_OPCODE_CATALOG_PAGE,
+                            (uint32(category) << GOSSIP_PAGE_BITS) |
+                                (page & ((1u << GOSSIP_PAGE_BITS) - 1)));
+}
+
+// Category and 1-based page of a catalog page payload; false if either is
+// out of range.
+constexpr bool DecodeCatalogPagePayload(uint32 payload,
+                                        BeastmasterPetCategory &category,
+                                        uint32 &page) {
+  uint32 index = payload >> GOSSIP_PAGE_BITS;
+  page = payload & ((1u << GOSSIP_PAGE_BITS) - 1);
+  if (index >= MAX_PET_CATEGORIES || !page)
+    return false;
+  category = BeastmasterPetCategory(index);
+  return true;
+}
+
+constexpr uint32 EncodeAdoptAction(uint32 entry) {
+  return EncodeGossipAction(GOSSIP_OPCODE_ADOPT, entry);
+}
+
+// Core gossip icons (GossipOptionIcon) for the navigation items, passed in
+// so this file builds without the core.
+struct BeastmasterMenuIcons {
+  uint32 back;
+  uint32 navigation;
+};
+
+/**
+ * Renders every browse page of the catalog: Back, Previous and Next, then
+ * up to PET_PAGE_SIZE pets. Empty categories get a page with just Back.
+ */
+BeastmasterGossipPages BuildCatalogPages(BeastmasterCatalog const &catalog,
+                                         BeastmasterMenuIcons icons);
+
+#endif // _BEASTMASTER_GOSSIP_MENU_H_
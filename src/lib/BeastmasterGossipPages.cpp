@@ -0,0 +1,55 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterGossipPages.h"
+
+void BeastmasterGossipPages::AddPage(uint32 category) {
+  if (category >= _pages.size())
+    _pages.resize(category + 1);
+  uint32 begin = uint32(_items.size());
+  _pages[category].push_back({begin, begin});
+  _lastCategory = category;
+}
+
+void BeastmasterGossipPages::AddItem(BeastmasterGossipItem item) {
+  _items.push_back(std::move(item));
+  _pages[_lastCategory].back().end = uint32(_items.size());
+}
+
+std::span<BeastmasterGossipItem const>
+BeastmasterGossipPages::GetPage(uint32 category, uint32 page) const {
+  if (!page || page > GetPageCount(category))
+    return {};
+  PageRange const &range = _pages[category][page - 1];
+  return std::span<BeastmasterGossipItem const>(_items).subspan(
+      range.begin, range.end - range.begin);
+}
+
+std::size_t BeastmasterGossipPages::GetMemoryUsage() const {
+  std::size_t bytes = _items.capacity() * sizeof(BeastmasterGossipItem);
+  for (auto const &item : _items) {
+    // Only strings past the small-string buffer own a heap block.
+    if (item.text.capacity() > 15)
+      bytes += item.text.capacity() + 1;
+    if (item.tamedText.capacity() > 15)
+      bytes += item.tamedText.capacity() + 1;
+  }
+  for (auto const &pages : _pages)
+    bytes += sizeof(pages) + pages.capacity() * sizeof(PageRange);
+  return bytes;
+}
@@ -0,0 +1,76 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_GOSSIP_PAGES_H_
+#define _BEASTMASTER_GOSSIP_PAGES_H_
+
+#include "BeastmasterDefines.h"
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * BeastmasterGossipItem
+ * One prebuilt gossip menu item. Pet items carry their catalog row and a
+ * second text for players who already have the pet.
+ */
+struct BeastmasterGossipItem {
+  static constexpr uint32 NO_ROW = ~uint32(0);
+
+  uint32 icon;
+  uint32 action;
+  uint32 row = NO_ROW;
+  std::string text;
+  std::string tamedText;
+};
+
+/**
+ * BeastmasterGossipPages
+ * The catalog browse menus, rendered once per catalog snapshot: every page
+ * of every category as a ready list of items, including navigation. Serving
+ * a page only copies the items into the player's menu.
+ */
+class BeastmasterGossipPages {
+public:
+  // Starts a new page of the given category; pages are numbered from 1 in
+  // the order they are added.
+  void AddPage(uint32 category);
+  void AddItem(BeastmasterGossipItem item);
+
+  // Items of the page, or an empty span if there is no such page.
+  std::span<BeastmasterGossipItem const> GetPage(uint32 category,
+                                                 uint32 page) const;
+
+  uint32 GetPageCount(uint32 category) const {
+    return category < _pages.size() ? uint32(_pages[category].size()) : 0;
+  }
+
+  std::size_t GetMemoryUsage() const;
+
+private:
+  struct PageRange {
+    uint32 begin;
+    uint32 end;
+  };
+
+  std::vector<BeastmasterGossipItem> _items;
+  std::vector<std::vector<PageRange>> _pages; // [category][page - 1]
+  uint32 _lastCategory = 0;
+};
+
+#endif // _BEASTMASTER_GOSSIP_PAGES_H_
@@ -0,0 +1,158 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterJournalQueue.h"
+
+void BeastmasterJournalQueue::Insert(uint32 owner, uint32 entry,
+                                     std::string const &name, time_t now) {
+  std::lock_guard<BeastmasterMutex> lock(_lock);
+  auto [it, inserted] =
+      _pending.try_emplace(MakeKey(owner, entry), Op{OP_INSERT, name, now});
+  if (inserted) {
+    _pendingCount.store(_pending.size(), std::memory_order_relaxed);
+    return;
+  }
+
+  // An insert keeps the existing row, like INSERT IGNORE: only a pet
+  // deleted in the meantime is tracked again, under the new name.
+  Op &op = it->second;
+  if (op.type == OP_DELETE)
+    op = Op{OP_REPLACE, name, now};
+}
+
+void BeastmasterJournalQueue::Rename(uint32 owner, uint32 entry,
+                                     std::string const &name) {
+  std::lock_guard<BeastmasterMutex> lock(_lock);
+  auto [it, inserted] =
+      _pending.try_emplace(MakeKey(owner, entry), Op{OP_RENAME, name, 0});
+  if (inserted) {
+    _pendingCount.store(_pending.size(), std::memory_order_relaxed);
+    return;
+  }
+
+  // Pending inserts take the new name; a deleted pet stays deleted.
+  Op &op = it->second;
+  if (op.type != OP_DELETE)
+    op.name = name;
+}
+
+void BeastmasterJournalQueue::Delete(uint32 owner, uint32 entry) {
+  // Always written: a pending insert may have been for a pet the owner
+  // already had, so dropping both would leave the row behind.
+  std::lock_guard<BeastmasterMutex> lock(_lock);
+  _pending.insert_or_assign(MakeKey(owner, entry), Op{OP_DELETE, {}, 0});
+  _pendingCount.store(_pending.size(), std::memory_order_relaxed);
+}
+
+bool BeastmasterJournalQueue::Flush(Writer const &write) {
+  std::unique_lock<BeastmasterMutex> lock(_lock);
+  if (_pending.empty() || _committing)
+    return false;
+
+  OpMap ops;
+  ops.swap(_pending);
+  Hand(std::move(ops), lock, write);
+  return true;
+}
+
+bool BeastmasterJournalQueue::FlushOwner(uint32 owner, Writer const &write) {
+  std::unique_lock<BeastmasterMutex> lock(_lock);
+  if (_committing)
+    return false;
+
+  auto first = _pending.lower_bound(MakeKey(owner, 0));
+  auto last = _pending.upper_bound(MakeKey(owner, ~uint32(0)));
+  if (first == last)
+    return false;
+
+  OpMap ops;
+  while (first != last)
+    ops.insert(_pending.extract(first++));
+  Hand(std::move(ops), lock, write);
+  return true;
+}
+
+void BeastmasterJournalQueue::Hand(OpMap ops,
+                                   std::unique_lock<BeastmasterMutex> &lock,
+                                   Writer const &write) {
+  _pendingCount.store(_pending.size(), std::memory_order_relaxed);
+
+  Batch batch;
+  batch.reserve(ops.size());
+  for (auto const &[key, op] : ops)
+    batch.push_back({uint32(key >> 32), uint32(key), op.type, op.name,
+                     op.date});
+
+  _inFlight.swap(ops);
+  _committing = true;
+  lock.unlock();
+  write(batch);
+}
+
+void BeastmasterJournalQueue::Committed() {
+  std::lock_guard<BeastmasterMutex> lock(_lock);
+  _inFlight.clear();
+  _committing = false;
+}
+
+bool BeastmasterJournalQueue::IsCommitting() const {
+  std::lock_guard<BeastmasterMutex> lock(_lock);
+  return _committing;
+}
+
+/*static*/ void
+BeastmasterJournalQueue::CollectOwner(OpMap const &ops, uint32 owner,
+                                      std::vector<PendingOp> &out) {
+  auto last = ops.upper_bound(MakeKey(owner, ~uint32(0)));
+  for (auto it = ops.lower_bound(MakeKey(owner, 0)); it != last; ++it)
+    out.push_back({owner, uint32(it->first), it->second.type, it->second.name,
+                   it->second.date});
+}
+
+std::vector<BeastmasterJournalQueue::PendingOp>
+BeastmasterJournalQueue::GetPending(uint32 owner) const {
+  std::vector<PendingOp> result;
+  std::lock_guard<BeastmasterMutex> lock(_lock);
+  CollectOwner(_inFlight, owner, result);
+  CollectOwner(_pending, owner, result);
+  return result;
+}
+
+void ApplyPendingOps(std::vector<BeastmasterJournalQueue::PendingOp> const &ops,
+                     BeastmasterTrackedPageBuilder &page) {
+  for (auto const &op : ops) {
+    switch (op.type) {
+    case BeastmasterJournalQueue::OP_INSERT:
+      // INSERT IGNORE keeps an existing row. A row on another page cannot
+      // be seen here, but inserts are only journaled for pets not known to
+      // be tracked.
+      if (page.Has(op.entry))
+        break;
+      [[fallthrough]];
+    case BeastmasterJournalQueue::OP_REPLACE:
+      page.Insert({op.entry, op.name, op.date});
+      break;
+    case BeastmasterJournalQueue::OP_RENAME:
+      page.Rename(op.entry, op.name);
+      break;
+    case BeastmasterJournalQueue::OP_DELETE:
+      page.Remove(op.entry);
+      break;
+    }
+  }
+}
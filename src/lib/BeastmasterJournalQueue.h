@@ -0,0 +1,132 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_JOURNAL_QUEUE_H_
+#define _BEASTMASTER_JOURNAL_QUEUE_H_
+
+#include "BeastmasterDefines.h"
+#include "BeastmasterMutex.h"
+#include "BeastmasterTrackedPages.h"
+#include <atomic>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * BeastmasterJournalQueue
+ * The coalescing and batching behind BeastmasterJournal, without the
+ * database. Writes to the same (owner_guid, entry) are coalesced into a
+ * single pending operation, and pending operations are handed to a writer
+ * a batch at a time. The writer reports back through Committed(); until
+ * then no other batch is handed out, so two batches touching the same pet
+ * never run out of order, and the batch stays visible to GetPending().
+ *
+ * Thread-safe; GetPendingCount() takes no lock, so it is cheap to poll.
+ */
+class BeastmasterJournalQueue {
+public:
+  enum OpType : uint8 {
+    OP_INSERT,  // Track a pet unless the owner already has it
+    OP_RENAME,  // Change the name of a tracked pet
+    OP_DELETE,  // Stop tracking a pet
+    OP_REPLACE, // Deleted, then tamed again: a new row with a new date
+  };
+
+  struct PendingOp {
+    uint32 owner;
+    uint32 entry;
+    OpType type;
+    std::string name;
+    time_t date; // When the insert was recorded; written as date_tamed
+  };
+
+  using Batch = std::vector<PendingOp>;
+
+  // Pending operations that warrant a flush before the interval is up.
+  static constexpr std::size_t MAX_PENDING = 1000;
+
+  // Writes a batch, e.g. as one transaction. Called without the queue lock,
+  // so it may call Committed() itself once the write is done.
+  using Writer = std::function<void(Batch const &)>;
+
+  void Insert(uint32 owner, uint32 entry, std::string const &name,
+              time_t now);
+  void Rename(uint32 owner, uint32 entry, std::string const &name);
+  void Delete(uint32 owner, uint32 entry);
+
+  // Hands every pending operation to the writer as one batch. False if
+  // there is nothing to write or the previous batch is still outstanding.
+  bool Flush(Writer const &write);
+
+  // Hands the pending operations of one owner to the writer, e.g. at
+  // logout, under the same rules as Flush().
+  bool FlushOwner(uint32 owner, Writer const &write);
+
+  // The outstanding batch has completed, whether or not it succeeded: its
+  // rows will not show up later either way.
+  void Committed();
+
+  bool IsCommitting() const;
+
+  /**
+   * Operations of the owner that a query issued now may not see yet: those
+   * of the outstanding batch, then the pending ones. Apply them, in order,
+   * on top of a query result.
+   */
+  std::vector<PendingOp> GetPending(uint32 owner) const;
+
+  std::size_t GetPendingCount() const {
+    return _pendingCount.load(std::memory_order_relaxed);
+  }
+
+private:
+  using OpKey = uint64; // owner_guid << 32 | entry
+
+  struct Op {
+    OpType type;
+    std::string name;
+    time_t date;
+  };
+
+  using OpMap = std::map<OpKey, Op>;
+
+  static OpKey MakeKey(uint32 owner, uint32 entry) {
+    return (uint64(owner) << 32) | entry;
+  }
+
+  // Moves the operations in flight and hands them to the writer.
+  void Hand(OpMap ops, std::unique_lock<BeastmasterMutex> &lock,
+            Writer const &write);
+
+  static void CollectOwner(OpMap const &ops, uint32 owner,
+                           std::vector<PendingOp> &out);
+
+  mutable BeastmasterMutex _lock{LOCK_SITE_JOURNAL};
+  OpMap _pending;
+  std::atomic<std::size_t> _pendingCount{0}; // _pending.size()
+  OpMap _inFlight; // The outstanding batch
+  bool _committing = false;
+};
+
+// Applies GetPending() on top of a page read from beastmaster_tamed_pets.
+void ApplyPendingOps(std::vector<BeastmasterJournalQueue::PendingOp> const &ops,
+                     BeastmasterTrackedPageBuilder &page);
+
+#endif // _BEASTMASTER_JOURNAL_QUEUE_H_
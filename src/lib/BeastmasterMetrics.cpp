@@ -0,0 +1,215 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterMetrics.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+using namespace BeastmasterMetrics;
+
+// Written only by the owning thread, so increments are a plain load and
+// store; the atomics just make the reads from Collect() well defined.
+struct ThreadMetrics {
+  std::array<std::array<std::atomic<uint64>, BUCKET_COUNT>, MAX_METRICS>
+      buckets{};
+  std::array<std::atomic<uint64>, MAX_METRICS> totals{};
+  std::array<std::atomic<uint64>, MAX_METRICS> maxima{};
+  std::array<std::atomic<uint64>, MAX_COUNTERS> counters{};
+  bool inUse = true; // Guarded by Registry::lock
+};
+
+struct Window {
+  std::array<uint64, BUCKET_COUNT> buckets{};
+  uint64 total = 0;
+};
+
+// Blocks outlive their threads: a thread that exits hands its block to the
+// next new thread, so short-lived threads neither lose samples nor leak.
+struct Registry {
+  std::mutex lock;
+  std::vector<std::unique_ptr<ThreadMetrics>> threads;
+  std::array<Window, MAX_METRICS> baseline; // Sums at the last Reset()
+};
+
+Registry &GetRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+struct ThreadSlot {
+  ThreadMetrics *metrics = nullptr;
+
+  ~ThreadSlot() {
+    if (!metrics)
+      return;
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.lock);
+    metrics->inUse = false;
+  }
+};
+
+thread_local ThreadSlot Slot;
+
+ThreadMetrics &GetThreadMetrics() {
+  if (Slot.metrics)
+    return *Slot.metrics;
+
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.lock);
+  for (auto &metrics : registry.threads) {
+    if (!metrics->inUse) {
+      metrics->inUse = true;
+      Slot.metrics = metrics.get();
+      return *Slot.metrics;
+    }
+  }
+  Slot.metrics =
+      registry.threads.emplace_back(std::make_unique<ThreadMetrics>()).get();
+  return *Slot.metrics;
+}
+
+void Add(std::atomic<uint64> &counter, uint64 value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+}
+
+// Called with the registry lock held.
+Window Sum(Registry const &registry, BeastmasterMetric metric,
+           uint64 &max) {
+  Window window;
+  max = 0;
+  for (auto const &metrics : registry.threads) {
+    for (uint32 i = 0; i < BUCKET_COUNT; ++i)
+      window.buckets[i] +=
+          metrics->buckets[metric][i].load(std::memory_order_relaxed);
+    window.total += metrics->totals[metric].load(std::memory_order_relaxed);
+    max = std::max(max,
+                   metrics->maxima[metric].load(std::memory_order_relaxed));
+  }
+  return window;
+}
+
+uint64 GetPercentile(Window const &window, uint64 count, uint64 max,
+                     uint64 permille) {
+  uint64 rank = std::max<uint64>(1, (count * permille + 999) / 1000);
+  uint64 seen = 0;
+  for (uint32 i = 0; i < BUCKET_COUNT; ++i) {
+    seen += window.buckets[i];
+    if (seen >= rank)
+      return std::min(max, i + 1 < BUCKET_COUNT
+                               ? GetBucketLowerBound(i + 1) - 1
+                               : MAX_VALUE);
+  }
+  return max;
+}
+} // namespace
+
+namespace BeastmasterMetrics {
+void SetEnabled(bool enabled) {
+  Enabled.store(enabled, std::memory_order_relaxed);
+}
+
+char const *GetName(BeastmasterMetric metric) {
+  constexpr char const *Names[MAX_METRICS] = {
+      "ShowMainMenu",
+      "GossipSelect: main menu",
+      "GossipSelect: catalog page",
+      "GossipSelect: unlearn skills",
+      "GossipSelect: stable",
+      "GossipSelect: vendor",
+      "GossipSelect: tracked pets",
+      "GossipSelect: summon tracked",
+      "GossipSelect: rename tracked",
+      "GossipSelect: delete tracked",
+      "CreatePet",
+      "ShowTrackedPetsMenu",
+      "Rename validation",
+      "DB: tamed pet entries",
+      "DB: tamed pets",
+      "DB: journal commit",
+      "DB: tames",
+      "DB: tames checksum"};
+  return metric < MAX_METRICS ? Names[metric] : "";
+}
+
+void Record(BeastmasterMetric metric, uint64 nanoseconds) {
+  ThreadMetrics &metrics = GetThreadMetrics();
+  Add(metrics.buckets[metric][GetBucket(nanoseconds)], 1);
+  Add(metrics.totals[metric], nanoseconds);
+  if (nanoseconds > metrics.maxima[metric].load(std::memory_order_relaxed))
+    metrics.maxima[metric].store(nanoseconds, std::memory_order_relaxed);
+}
+
+Summary Collect(BeastmasterMetric metric, bool sinceReset /*= true*/) {
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.lock);
+
+  uint64 max;
+  Window window = Sum(registry, metric, max);
+  Window const &baseline =
+      sinceReset ? registry.baseline[metric] : Window();
+
+  Summary summary;
+  uint32 highest = 0;
+  for (uint32 i = 0; i < BUCKET_COUNT; ++i) {
+    window.buckets[i] -= baseline.buckets[i];
+    summary.count += window.buckets[i];
+    if (window.buckets[i])
+      highest = i;
+  }
+  if (!summary.count)
+    return summary;
+
+  // The all-time maximum may predate the window; its highest bucket does not.
+  if (highest + 1 < BUCKET_COUNT)
+    max = std::min(max, GetBucketLowerBound(highest + 1) - 1);
+
+  summary.totalNanoseconds = window.total - baseline.total;
+  summary.p50 = GetPercentile(window, summary.count, max, 500);
+  summary.p99 = GetPercentile(window, summary.count, max, 990);
+  summary.p999 = GetPercentile(window, summary.count, max, 999);
+  summary.max = max;
+  return summary;
+}
+
+void Reset() {
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.lock);
+  for (uint32 metric = 0; metric < MAX_METRICS; ++metric) {
+    uint64 max;
+    registry.baseline[metric] =
+        Sum(registry, BeastmasterMetric(metric), max);
+  }
+}
+
+void Increment(BeastmasterCounter counter) {
+  Add(GetThreadMetrics().counters[counter], 1);
+}
+
+uint64 GetCount(BeastmasterCounter counter) {
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.lock);
+  uint64 count = 0;
+  for (auto const &metrics : registry.threads)
+    count += metrics->counters[counter].load(std::memory_order_relaxed);
+  return count;
+}
+} // namespace BeastmasterMetrics
@@ -0,0 +1,181 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_METRICS_H_
+#define _BEASTMASTER_METRICS_H_
+
+#include "BeastmasterDefines.h"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+
+// Timed operations: the module's entry points, each GossipSelect branch and
+// every database round trip.
+enum BeastmasterMetric : uint8 {
+  METRIC_SHOW_MAIN_MENU = 0,
+  METRIC_GOSSIP_MAIN_MENU,
+  METRIC_GOSSIP_CATALOG_PAGE,
+  METRIC_GOSSIP_REMOVE_SKILLS,
+  METRIC_GOSSIP_STABLE,
+  METRIC_GOSSIP_VENDOR,
+  METRIC_GOSSIP_TRACKED_MENU,
+  METRIC_GOSSIP_TRACKED_SUMMON,
+  METRIC_GOSSIP_TRACKED_RENAME,
+  METRIC_GOSSIP_TRACKED_DELETE,
+  METRIC_CREATE_PET, // The adopt branch of GossipSelect
+  METRIC_SHOW_TRACKED_PETS_MENU,
+  METRIC_RENAME_VALIDATION,
+  METRIC_DB_TAMED_PET_ENTRIES,
+  METRIC_DB_TAMED_PETS,
+  METRIC_DB_JOURNAL_COMMIT,
+  METRIC_DB_TAMES,
+  METRIC_DB_TAMES_CHECKSUM,
+  MAX_METRICS
+};
+
+// Event counts, recorded whether or not timing is enabled.
+enum BeastmasterCounter : uint8 {
+  COUNTER_ADOPTIONS_NORMAL = 0, // One per BeastmasterPetCategory
+  COUNTER_ADOPTIONS_EXOTIC,
+  COUNTER_ADOPTIONS_RARE,
+  COUNTER_ADOPTIONS_RARE_EXOTIC,
+  COUNTER_SUMMON_COOLDOWN_REJECTIONS,
+  COUNTER_PROFANITY_REJECTIONS,
+  MAX_COUNTERS
+};
+
+/**
+ * BeastmasterMetrics
+ * Call counts and latency histograms per metric, and event counters. Every
+ * thread records into its own block, so the hot path takes no lock and
+ * shares no cache line; Collect() and GetCount() sum the blocks of all
+ * threads.
+ *
+ * Histograms have fixed log-linear buckets: eight per power of two, which
+ * bounds the error of a reported percentile to 12.5%. Values are in
+ * nanoseconds, up to about 18 minutes.
+ *
+ * While disabled, Start() returns an empty time point and nothing is
+ * timed: the cost is one relaxed load per timed operation. Counters are
+ * always recorded.
+ */
+namespace BeastmasterMetrics {
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32 SUB_BUCKET_BITS = 3;
+constexpr uint32 SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+constexpr uint64 MAX_VALUE = (uint64(1) << 40) - 1;
+
+constexpr uint32 GetBucket(uint64 nanoseconds) {
+  uint64 value = nanoseconds < MAX_VALUE ? nanoseconds : MAX_VALUE;
+  int width = std::bit_width(value);
+  uint32 shift = width > int(SUB_BUCKET_BITS + 1)
+                     ? uint32(width) - (SUB_BUCKET_BITS + 1)
+                     : 0;
+  return shift * SUB_BUCKETS + uint32(value >> shift);
+}
+
+// Smallest value that falls into the bucket.
+constexpr uint64 GetBucketLowerBound(uint32 bucket) {
+  if (bucket < 2 * SUB_BUCKETS)
+    return bucket;
+  uint32 shift = bucket / SUB_BUCKETS - 1;
+  return uint64(bucket - shift * SUB_BUCKETS) << shift;
+}
+
+constexpr uint32 BUCKET_COUNT = GetBucket(MAX_VALUE) + 1;
+
+static_assert(GetBucket(15) == 15 && GetBucket(16) == 16);
+static_assert(GetBucketLowerBound(GetBucket(1000)) <= 1000 &&
+              GetBucketLowerBound(GetBucket(1000) + 1) > 1000);
+
+struct Summary {
+  uint64 count = 0;
+  uint64 totalNanoseconds = 0;
+  uint64 p50 = 0; // Nanoseconds, upper bound of the percentile's bucket
+  uint64 p99 = 0;
+  uint64 p999 = 0;
+  uint64 max = 0;
+};
+
+// Whether timers record; toggled by BeastMaster.Metrics.Enable.
+inline std::atomic<bool> Enabled{true};
+
+inline bool IsEnabled() { return Enabled.load(std::memory_order_relaxed); }
+void SetEnabled(bool enabled);
+
+char const *GetName(BeastmasterMetric metric);
+
+// Adds one sample to the calling thread's histogram of the metric.
+void Record(BeastmasterMetric metric, uint64 nanoseconds);
+
+// Start of a timed operation, or an empty time point while disabled.
+inline Clock::time_point Start() {
+  return IsEnabled() ? Clock::now() : Clock::time_point();
+}
+
+// Records the time since Start(); does nothing for an empty start. Used
+// directly for operations that complete in a callback.
+inline void RecordSince(BeastmasterMetric metric, Clock::time_point start) {
+  if (start == Clock::time_point())
+    return;
+  Record(metric, uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            Clock::now() - start)
+                            .count()));
+}
+
+// Samples of all threads since the last Reset(), or since startup.
+Summary Collect(BeastmasterMetric metric, bool sinceReset = true);
+
+// Starts a new measurement window for Collect(). Threads keep recording.
+void Reset();
+
+void Increment(BeastmasterCounter counter);
+
+// Total of all threads since startup.
+uint64 GetCount(BeastmasterCounter counter);
+} // namespace BeastmasterMetrics
+
+/**
+ * BeastmasterTimer
+ * Records the lifetime of the scope under its metric. The metric can be set
+ * or changed later, e.g. once the branch of a GossipSelect is known; a timer
+ * without one records nothing.
+ */
+class BeastmasterTimer {
+public:
+  BeastmasterTimer() : _start(BeastmasterMetrics::Start()) {}
+  explicit BeastmasterTimer(BeastmasterMetric metric)
+      : _metric(metric), _start(BeastmasterMetrics::Start()) {}
+  ~BeastmasterTimer() {
+    if (_metric != MAX_METRICS)
+      BeastmasterMetrics::RecordSince(_metric, _start);
+  }
+
+  BeastmasterTimer(BeastmasterTimer const &) = delete;
+  BeastmasterTimer &operator=(BeastmasterTimer const &) = delete;
+
+  void SetMetric(BeastmasterMetric metric) { _metric = metric; }
+
+private:
+  BeastmasterMetric _metric = MAX_METRICS;
+  BeastmasterMetrics::Clock::time_point _start;
+};
+
+#endif // _BEASTMASTER_METRICS_H_
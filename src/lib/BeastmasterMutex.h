@@ -0,0 +1,91 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_MUTEX_H_
+#define _BEASTMASTER_MUTEX_H_
+
+#include "BeastmasterDefines.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+// How often, and for how long in total, callers had to wait for a lock.
+struct BeastmasterLockStats {
+  std::atomic<uint64> contentions{0};
+  std::atomic<uint64> waitNanoseconds{0};
+};
+
+// The module's shared locks, each reported on its own.
+enum BeastmasterLockSite {
+  LOCK_SITE_TRACKED_PETS_CACHE = 0,
+  LOCK_SITE_COOLDOWNS,
+  LOCK_SITE_JOURNAL,
+  LOCK_SITE_SUMMON_POOL,
+  MAX_LOCK_SITES
+};
+
+inline char const *GetLockSiteName(BeastmasterLockSite site) {
+  constexpr char const *Names[MAX_LOCK_SITES] = {
+      "tracked pets cache", "cooldowns", "journal", "summon pool"};
+  return Names[site];
+}
+
+inline BeastmasterLockStats &GetLockStats(BeastmasterLockSite site) {
+  static std::array<BeastmasterLockStats, MAX_LOCK_SITES> stats;
+  return stats[site];
+}
+
+/**
+ * BeastmasterMutex
+ * A std::mutex that records contended acquisitions in BeastmasterLockStats.
+ * An uncontended lock() is a single try_lock, so this costs nothing extra
+ * until threads actually collide; only then is the wait timed.
+ */
+class BeastmasterMutex {
+public:
+  explicit BeastmasterMutex(BeastmasterLockStats &stats) : _stats(stats) {}
+  explicit BeastmasterMutex(BeastmasterLockSite site)
+      : _stats(GetLockStats(site)) {}
+
+  BeastmasterMutex(BeastmasterMutex const &) = delete;
+  BeastmasterMutex &operator=(BeastmasterMutex const &) = delete;
+
+  void lock() {
+    if (_mutex.try_lock())
+      return;
+
+    auto start = std::chrono::steady_clock::now();
+    _mutex.lock();
+    auto waited = std::chrono::steady_clock::now() - start;
+    _stats.contentions.fetch_add(1, std::memory_order_relaxed);
+    _stats.waitNanoseconds.fetch_add(
+        uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(waited)
+                   .count()),
+        std::memory_order_relaxed);
+  }
+
+  bool try_lock() { return _mutex.try_lock(); }
+  void unlock() { _mutex.unlock(); }
+
+private:
+  std::mutex _mutex;
+  BeastmasterLockStats &_stats;
+};
+
+#endif // _BEASTMASTER_MUTEX_H_
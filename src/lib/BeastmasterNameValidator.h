@@ -0,0 +1,168 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_NAME_VALIDATOR_H_
+#define _BEASTMASTER_NAME_VALIDATOR_H_
+
+#include "BeastmasterDefines.h"
+#include <array>
+#include <string_view>
+
+/**
+ * BeastmasterNamePolicy
+ * Optional limits on top of the base pet name rules. The defaults add no
+ * limits.
+ */
+struct BeastmasterNamePolicy {
+  uint32 maxConsecutiveSpaces = 0;      // 0 = no limit
+  uint32 maxConsecutiveApostrophes = 0; // 0 = no limit
+  uint32 minLetters = 0;
+  // Also accept Latin-1, Latin Extended-A/B and Cyrillic letters.
+  bool allowUtf8Letters = false;
+};
+
+/**
+ * BeastmasterNameValidator
+ * Checks pet names without regex or allocation: one pass over the bytes
+ * with a constexpr character class table.
+ *
+ * Base rules: 2 to 16 characters, letters, spaces, hyphens and apostrophes
+ * only, starting and ending with a letter. With the default policy this is
+ * exactly ^[A-Za-z][A-Za-z \-']*[A-Za-z]$ on names of 2 to 16 bytes.
+ */
+class BeastmasterNameValidator {
+public:
+  static constexpr uint32 MIN_LENGTH = 2;
+  static constexpr uint32 MAX_LENGTH = 16;
+  // A valid name in bytes: MAX_LENGTH letters of up to 2 bytes each.
+  static constexpr uint32 MAX_BYTES = MAX_LENGTH * 2;
+
+  static constexpr bool IsValid(std::string_view name,
+                                BeastmasterNamePolicy const &policy = {}) {
+    uint32 length = 0;
+    uint32 letters = 0;
+    uint32 spaces = 0;
+    uint32 apostrophes = 0;
+    bool lastIsLetter = false;
+
+    for (std::size_t i = 0; i < name.size(); ++i) {
+      CharClass charClass = CharClasses[uint8(name[i])];
+      if (charClass == CHAR_UTF8_LEAD) {
+        if (!policy.allowUtf8Letters || !SkipUtf8Letter(name, i))
+          return false;
+        charClass = CHAR_LETTER;
+      }
+
+      switch (charClass) {
+      case CHAR_LETTER:
+        ++letters;
+        spaces = apostrophes = 0;
+        break;
+      case CHAR_SPACE:
+        if (!length || (policy.maxConsecutiveSpaces &&
+                        ++spaces > policy.maxConsecutiveSpaces))
+          return false;
+        apostrophes = 0;
+        break;
+      case CHAR_APOSTROPHE:
+        if (!length || (policy.maxConsecutiveApostrophes &&
+                        ++apostrophes > policy.maxConsecutiveApostrophes))
+          return false;
+        spaces = 0;
+        break;
+      case CHAR_HYPHEN:
+        if (!length)
+          return false;
+        spaces = apostrophes = 0;
+        break;
+      default:
+        return false;
+      }
+
+      lastIsLetter = charClass == CHAR_LETTER;
+      if (++length > MAX_LENGTH)
+        return false;
+    }
+
+    return length >= MIN_LENGTH && lastIsLetter &&
+           letters >= policy.minLetters;
+  }
+
+private:
+  enum CharClass : uint8 {
+    CHAR_INVALID = 0,
+    CHAR_LETTER,
+    CHAR_SPACE,
+    CHAR_HYPHEN,
+    CHAR_APOSTROPHE,
+    // Lead byte of a 2 byte UTF-8 sequence, where all accepted letters lie.
+    CHAR_UTF8_LEAD,
+  };
+
+  static constexpr std::array<CharClass, 256> CharClasses = [] {
+    std::array<CharClass, 256> table = {};
+    for (uint32 c = 'A'; c <= 'Z'; ++c)
+      table[c] = table[c - 'A' + 'a'] = CHAR_LETTER;
+    table[' '] = CHAR_SPACE;
+    table['-'] = CHAR_HYPHEN;
+    table['\''] = CHAR_APOSTROPHE;
+    for (uint32 c = 0xC2; c <= 0xDF; ++c)
+      table[c] = CHAR_UTF8_LEAD;
+    return table;
+  }();
+
+  /**
+   * Decodes the 2 byte UTF-8 sequence starting at name[i] and leaves i on
+   * its last byte. False unless it is well formed and a letter the core
+   * accepts in names (isExtendedLatinCharacter, isCyrillicCharacter):
+   * U+00C0 to U+024F except U+00D7 and U+00F7 (multiplication and division
+   * signs), and U+0400 to U+04FF. Marks, spaces, format characters and
+   * everything above U+07FF, emoji included, are turned away.
+   */
+  static constexpr bool SkipUtf8Letter(std::string_view name, std::size_t &i) {
+    if (i + 1 >= name.size() || (uint8(name[i + 1]) & 0xC0) != 0x80)
+      return false;
+
+    uint32 codePoint =
+        ((uint8(name[i]) & 0x1F) << 6) | (uint8(name[i + 1]) & 0x3F);
+    ++i;
+
+    return (codePoint >= 0xC0 && codePoint <= 0x24F && codePoint != 0xD7 &&
+            codePoint != 0xF7) ||
+           (codePoint >= 0x400 && codePoint <= 0x4FF);
+  }
+};
+
+static_assert(BeastmasterNameValidator::IsValid("Fluffy"));
+static_assert(BeastmasterNameValidator::IsValid("Mr Bo-Jangles"));
+static_assert(!BeastmasterNameValidator::IsValid(" Fluffy"));
+static_assert(!BeastmasterNameValidator::IsValid("Fluffy'"));
+static_assert(!BeastmasterNameValidator::IsValid("Fluffy2"));
+static_assert(!BeastmasterNameValidator::IsValid("F"));
+static_assert(BeastmasterNameValidator::IsValid(
+    "Zo\xC3\xAB", {.allowUtf8Letters = true}));
+static_assert(BeastmasterNameValidator::IsValid(
+    "\xD0\x91\xD0\xBE\xD0\xB1", {.allowUtf8Letters = true}));
+static_assert(!BeastmasterNameValidator::IsValid(
+    "Zo\xE2\x80\x8B" "e", {.allowUtf8Letters = true})); // U+200B
+static_assert(!BeastmasterNameValidator::IsValid(
+    "Zoe\xCC\x81" "e", {.allowUtf8Letters = true})); // U+0301
+static_assert(!BeastmasterNameValidator::IsValid(
+    "Zo\xC3\x97" "e", {.allowUtf8Letters = true})); // U+00D7
+
+#endif // _BEASTMASTER_NAME_VALIDATOR_H_
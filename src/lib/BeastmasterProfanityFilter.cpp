@@ -0,0 +1,159 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterProfanityFilter.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <utility>
+
+BeastmasterProfanityFilter::BeastmasterProfanityFilter(
+    std::vector<std::string> const &words, bool normalizeLeetspeak) {
+  for (uint32 c = 0; c < 256; ++c)
+    _fold[c] = uint8(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+  if (normalizeLeetspeak)
+    for (auto [from, to] : {std::pair{'0', 'o'}, {'1', 'i'}, {'3', 'e'},
+                            {'4', 'a'}, {'5', 's'}, {'7', 't'}, {'8', 'b'},
+                            {'@', 'a'}, {'$', 's'}, {'!', 'i'}, {'|', 'l'}})
+      _fold[uint8(from)] = uint8(to);
+
+  // Build the trie with per-state child lists first.
+  std::vector<std::vector<std::pair<uint8, uint32>>> children(1);
+  std::vector<bool> terminal(1, false);
+  for (std::string const &word : words) {
+    if (word.empty())
+      continue;
+    ++_wordCount;
+
+    uint32 state = ROOT;
+    for (char ch : word) {
+      uint8 label = _fold[uint8(ch)];
+      auto &edges = children[state];
+      auto it =
+          std::find_if(edges.begin(), edges.end(),
+                       [label](auto const &e) { return e.first == label; });
+      if (it != edges.end()) {
+        state = it->second;
+        continue;
+      }
+      uint32 next = uint32(children.size());
+      edges.emplace_back(label, next);
+      children.emplace_back();
+      terminal.push_back(false);
+      state = next;
+    }
+    terminal[state] = true;
+  }
+
+  // Flatten in breadth-first order, so every fail target (a shorter suffix)
+  // is complete before the states that point at it.
+  _states.assign(children.size(), State{0, ROOT, NO_STATE, 0, false});
+
+  std::vector<uint32> queue;
+  queue.reserve(children.size());
+  queue.push_back(ROOT);
+  for (std::size_t i = 0; i < queue.size(); ++i) {
+    uint32 state = queue[i];
+    auto &edges = children[state];
+    std::sort(edges.begin(), edges.end());
+
+    State &s = _states[state];
+    s.firstEdge = uint32(_edgeLabels.size());
+    s.edgeCount = uint16(edges.size());
+    s.output = s.output || terminal[state];
+    for (auto [label, next] : edges) {
+      _edgeLabels.push_back(label);
+      _edgeTargets.push_back(next);
+      queue.push_back(next);
+    }
+  }
+
+  // Dense rows for the root and its children. A child fails to the root, so
+  // its row is the root's row with its own edges on top.
+  std::array<uint32, 256> row;
+  row.fill(ROOT);
+  auto addDenseRow = [this](uint32 state, std::array<uint32, 256> row) {
+    State &s = _states[state];
+    for (uint32 e = s.firstEdge; e < s.firstEdge + s.edgeCount; ++e)
+      row[_edgeLabels[e]] = _edgeTargets[e];
+    s.denseRow = uint32(_denseRows.size() / 256);
+    _denseRows.insert(_denseRows.end(), row.begin(), row.end());
+  };
+  addDenseRow(ROOT, row);
+  std::copy_n(_denseRows.begin(), 256, row.begin());
+  for (auto [label, child] : children[ROOT])
+    addDenseRow(child, row);
+
+  // Fail links: the longest proper suffix that is also in the trie.
+  for (uint32 state : queue) {
+    State const &s = _states[state];
+    for (uint32 e = s.firstEdge; e < s.firstEdge + s.edgeCount; ++e) {
+      uint32 child = _edgeTargets[e];
+      uint32 fail = state == ROOT ? ROOT : Next(s.fail, _edgeLabels[e]);
+      _states[child].fail = fail;
+      _states[child].output = _states[child].output || _states[fail].output;
+    }
+  }
+
+  _edgeLabels.shrink_to_fit();
+  _edgeTargets.shrink_to_fit();
+}
+
+uint32 BeastmasterProfanityFilter::FindEdge(State const &state,
+                                            uint8 label) const {
+  auto first = _edgeLabels.begin() + state.firstEdge;
+  auto last = first + state.edgeCount;
+  auto it = std::lower_bound(first, last, label);
+  if (it == last || *it != label)
+    return NO_STATE;
+  return _edgeTargets[it - _edgeLabels.begin()];
+}
+
+bool BeastmasterProfanityFilter::Matches(std::string_view text) const {
+  uint32 state = ROOT;
+  for (char ch : text) {
+    state = Next(state, _fold[uint8(ch)]);
+    if (_states[state].output)
+      return true;
+  }
+  return false;
+}
+
+std::size_t BeastmasterProfanityFilter::GetMemoryUsage() const {
+  return sizeof(*this) + _states.capacity() * sizeof(State) +
+         _denseRows.capacity() * sizeof(uint32) + _edgeLabels.capacity() +
+         _edgeTargets.capacity() * sizeof(uint32);
+}
+
+/*static*/ bool
+BeastmasterProfanityFilter::ReadWordList(std::string const &path,
+                                         std::vector<std::string> &words) {
+  std::ifstream file(path);
+  if (!file.is_open())
+    return false;
+
+  std::string line;
+  while (std::getline(file, line)) {
+    while (!line.empty() && std::isspace(uint8(line.back())))
+      line.pop_back();
+    if (line.empty() || line[0] == '#' || line.starts_with("//"))
+      continue;
+    words.push_back(std::move(line));
+  }
+  return true;
+}
@@ -0,0 +1,93 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_PROFANITY_FILTER_H_
+#define _BEASTMASTER_PROFANITY_FILTER_H_
+
+#include "BeastmasterDefines.h"
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * BeastmasterProfanityFilter
+ * A list of banned words compiled into an Aho-Corasick automaton, so a name
+ * is checked against every word in one pass over its characters.
+ *
+ * Words and checked text are both case folded and, optionally, leetspeak
+ * normalized ("n4s7y" reads as "nasty") before matching. Immutable once
+ * built; see NpcBeastmaster for how file changes are picked up.
+ */
+class BeastmasterProfanityFilter {
+public:
+  BeastmasterProfanityFilter(std::vector<std::string> const &words,
+                             bool normalizeLeetspeak);
+
+  // True if any word occurs anywhere in the text.
+  bool Matches(std::string_view text) const;
+
+  std::size_t GetWordCount() const { return _wordCount; }
+  std::size_t GetStateCount() const { return _states.size(); }
+  std::size_t GetMemoryUsage() const;
+
+  /**
+   * Reads one word per line; blank lines and lines starting with '#' or
+   * '//' are skipped. Returns false if the file cannot be opened.
+   */
+  static bool ReadWordList(std::string const &path,
+                           std::vector<std::string> &words);
+
+private:
+  static constexpr uint32 ROOT = 0;
+  static constexpr uint32 NO_STATE = ~uint32(0);
+
+  struct State {
+    uint32 firstEdge;
+    uint32 fail;
+    uint32 denseRow; // Full transition row, or NO_STATE
+    uint16 edgeCount;
+    bool output; // A word ends here or at a state on the fail chain
+  };
+
+  uint32 FindEdge(State const &state, uint8 label) const;
+
+  uint32 Next(uint32 state, uint8 label) const {
+    for (;;) {
+      State const &s = _states[state];
+      if (s.denseRow != NO_STATE)
+        return _denseRows[s.denseRow * 256 + label];
+      uint32 next = FindEdge(s, label);
+      if (next != NO_STATE)
+        return next;
+      state = s.fail;
+    }
+  }
+
+  std::array<uint8, 256> _fold;
+  // The root and the states one character deep, where scans spend most of
+  // their time, get complete transition rows (fail links already applied);
+  // deeper states keep their edges sorted by label for a short search.
+  std::vector<uint32> _denseRows;
+  std::vector<State> _states;
+  std::vector<uint8> _edgeLabels;
+  std::vector<uint32> _edgeTargets;
+  std::size_t _wordCount = 0;
+};
+
+#endif // _BEASTMASTER_PROFANITY_FILTER_H_
@@ -0,0 +1,47 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_SNAPSHOT_H_
+#define _BEASTMASTER_SNAPSHOT_H_
+
+#include <atomic>
+#include <memory>
+
+/**
+ * BeastmasterSnapshot
+ * Holds an immutable object that is replaced as a whole on reload.
+ *
+ * Readers take a shared_ptr copy and keep using it for the duration of their
+ * call; a concurrent Publish() never tears what they see, and the previous
+ * object is freed once the last reader drops its reference.
+ */
+template <typename T> class BeastmasterSnapshot {
+public:
+  using Ptr = std::shared_ptr<T const>;
+
+  Ptr Get() const { return _current.load(std::memory_order_acquire); }
+
+  void Publish(Ptr next) {
+    _current.store(std::move(next), std::memory_order_release);
+  }
+
+private:
+  std::atomic<Ptr> _current;
+};
+
+#endif // _BEASTMASTER_SNAPSHOT_H_
@@ -0,0 +1,120 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterTameRows.h"
+#include "BeastmasterGossipMenu.h"
+#include <algorithm>
+#include <future>
+#include <thread>
+
+namespace {
+// Fewer rows than this per chunk are not worth a thread.
+constexpr std::size_t TAME_VALIDATION_MIN_CHUNK = 256;
+
+// Families whose pets are listed with the trainer icon; all others get the
+// vendor icon. Bit n is family n.
+constexpr uint64 TrainerIconFamilies =
+    (1ull << 1) | (1ull << 2) | (1ull << 3) | (1ull << 4) | (1ull << 7) |
+    (1ull << 8) | (1ull << 9) | (1ull << 10) | (1ull << 15) | (1ull << 20) |
+    (1ull << 21) | (1ull << 24) | (1ull << 25) | (1ull << 27) | (1ull << 30) |
+    (1ull << 31) | (1ull << 34);
+
+// Only touches the given rows, so disjoint chunks can run concurrently.
+BeastmasterTameRowStats ValidateChunk(std::span<BeastmasterTameRow> rows,
+                                      BeastmasterTameRules const &rules) {
+  BeastmasterTameRowStats stats;
+  for (BeastmasterTameRow &row : rows) {
+    if (row.entry > MAX_ADOPT_ENTRY) {
+      ++stats.entryTooLarge;
+      continue;
+    }
+    if (!row.typeFlags) {
+      ++stats.missingTemplate;
+      continue;
+    }
+    if (!(*row.typeFlags & CREATURE_TEMPLATE_TAMEABLE)) {
+      ++stats.notTameable;
+      continue;
+    }
+
+    // The core decides exoticness from the template when taming, so that
+    // wins over the rarity column.
+    BeastmasterPetRarity rarity =
+        (*row.typeFlags & CREATURE_TEMPLATE_EXOTIC_PET) ? PET_RARITY_EXOTIC
+                                                        : PET_RARITY_NORMAL;
+    if (rarity != row.rarity) {
+      ++stats.rarityCorrected;
+      row.rarity = rarity;
+    }
+
+    row.icon =
+        row.family < 64 && (TrainerIconFamilies & (1ull << row.family))
+            ? rules.trainerIcon
+            : rules.vendorIcon;
+    row.category = GetPetCategory(rules, row.entry, rarity);
+    row.valid = true;
+  }
+  return stats;
+}
+} // namespace
+
+BeastmasterPetCategory GetPetCategory(BeastmasterTameRules const &rules,
+                                      uint32 entry,
+                                      BeastmasterPetRarity rarity) {
+  if (rules.rarePetEntries.count(entry))
+    return PET_CATEGORY_RARE;
+  if (rules.rareExoticPetEntries.count(entry))
+    return PET_CATEGORY_RARE_EXOTIC;
+  return rarity == PET_RARITY_EXOTIC ? PET_CATEGORY_EXOTIC
+                                     : PET_CATEGORY_NORMAL;
+}
+
+BeastmasterTameRowStats
+ValidateTameRows(std::vector<BeastmasterTameRow> &rows,
+                 BeastmasterTameRules const &rules, std::size_t &chunks) {
+  std::size_t workers = std::clamp<std::size_t>(
+      rows.size() / TAME_VALIDATION_MIN_CHUNK, 1,
+      std::max(1u, std::thread::hardware_concurrency()));
+  std::size_t chunkSize = (rows.size() + workers - 1) / workers;
+
+  std::vector<std::future<BeastmasterTameRowStats>> futures;
+  for (std::size_t first = 0; first < rows.size(); first += chunkSize) {
+    std::span<BeastmasterTameRow> chunk =
+        std::span<BeastmasterTameRow>(rows).subspan(
+            first, std::min(chunkSize, rows.size() - first));
+    futures.push_back(std::async(std::launch::async, ValidateChunk, chunk,
+                                 std::cref(rules)));
+  }
+
+  BeastmasterTameRowStats stats;
+  for (auto &future : futures)
+    stats += future.get();
+  chunks = futures.size();
+  return stats;
+}
+
+std::shared_ptr<BeastmasterCatalog>
+BuildCatalog(std::vector<BeastmasterTameRow> const &rows, uint32 version) {
+  auto catalog = std::make_shared<BeastmasterCatalog>(version);
+  for (BeastmasterTameRow const &row : rows)
+    if (row.valid)
+      catalog->Add(row.entry, row.name, row.family, row.rarity, row.icon,
+                   row.category);
+  catalog->Finalize();
+  return catalog;
+}
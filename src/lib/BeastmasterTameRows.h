@@ -0,0 +1,90 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_TAME_ROWS_H_
+#define _BEASTMASTER_TAME_ROWS_H_
+
+#include "BeastmasterCatalog.h"
+#include "BeastmasterDefines.h"
+#include <memory>
+#include <optional>
+#include <set>
+#include <span>
+#include <string>
+#include <vector>
+
+// creature_template.type_flags
+constexpr uint32 CREATURE_TEMPLATE_TAMEABLE = 0x00000001;
+constexpr uint32 CREATURE_TEMPLATE_EXOTIC_PET = 0x00010000;
+
+// One beastmaster_tames row joined with its creature_template flags.
+struct BeastmasterTameRow {
+  uint32 entry = 0;
+  std::string name;
+  uint32 family = 0;
+  BeastmasterPetRarity rarity = PET_RARITY_NORMAL;
+  std::optional<uint32> typeFlags; // Empty without a creature_template row
+  uint32 icon = 0;
+  BeastmasterPetCategory category = PET_CATEGORY_NORMAL;
+  bool valid = false;
+};
+
+// Why rows were skipped or changed while validating.
+struct BeastmasterTameRowStats {
+  uint32 missingTemplate = 0;
+  uint32 notTameable = 0;
+  uint32 rarityCorrected = 0;
+  uint32 entryTooLarge = 0;
+
+  BeastmasterTameRowStats &operator+=(BeastmasterTameRowStats const &other) {
+    missingTemplate += other.missingTemplate;
+    notTameable += other.notTameable;
+    rarityCorrected += other.rarityCorrected;
+    entryTooLarge += other.entryTooLarge;
+    return *this;
+  }
+};
+
+// Core gossip icons (GossipOptionIcon) for the pet list and the rare lists
+// from the config, passed in so this file builds without the core.
+struct BeastmasterTameRules {
+  uint32 vendorIcon;
+  uint32 trainerIcon;
+  std::set<uint32> const &rarePetEntries;
+  std::set<uint32> const &rareExoticPetEntries;
+};
+
+// The catalog category of a pet, from the rare lists and its rarity.
+BeastmasterPetCategory GetPetCategory(BeastmasterTameRules const &rules,
+                                      uint32 entry,
+                                      BeastmasterPetRarity rarity);
+
+/**
+ * Checks the rows against their creature_template flags and classifies the
+ * valid ones. Rows are independent, so they are split into one chunk per
+ * core; chunks is set to the number used.
+ */
+BeastmasterTameRowStats
+ValidateTameRows(std::vector<BeastmasterTameRow> &rows,
+                 BeastmasterTameRules const &rules, std::size_t &chunks);
+
+// Builds and finalizes a catalog from the valid rows.
+std::shared_ptr<BeastmasterCatalog>
+BuildCatalog(std::vector<BeastmasterTameRow> const &rows, uint32 version);
+
+#endif // _BEASTMASTER_TAME_ROWS_H_
@@ -0,0 +1,113 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterTrackedPages.h"
+#include <algorithm>
+
+BeastmasterTrackedPageQuery BeastmasterTrackedPageInfo::GetRefresh() const {
+  if (!hasPrevious || !first.entry)
+    return {};
+  // Everything after a key just past the first pet, which is that pet on.
+  return {TRACKED_SEEK_AFTER, {first.tamedAt, first.entry + 1}};
+}
+
+void BeastmasterTrackedPageInfo::SetBounds(TrackedPetList const &pets) {
+  first = pets.empty() ? BeastmasterTrackedKey{}
+                       : BeastmasterTrackedKey::Of(pets.front());
+  last = pets.empty() ? BeastmasterTrackedKey{}
+                      : BeastmasterTrackedKey::Of(pets.back());
+}
+
+BeastmasterTrackedPageBuilder::BeastmasterTrackedPageBuilder(
+    BeastmasterTrackedPageQuery query, TrackedPetList rows)
+    : _query(query), _pets(std::move(rows)) {
+  if (_query.seek == TRACKED_SEEK_BEFORE) {
+    std::reverse(_pets.begin(), _pets.end());
+    _next = _query.key;
+    _hasNext = true;
+    if (_pets.size() > PET_TRACKED_PAGE_SIZE) {
+      _previous = BeastmasterTrackedKey::Of(_pets.front());
+      _pets.erase(_pets.begin());
+      _hasPrevious = true;
+    }
+    return;
+  }
+
+  if (_query.seek == TRACKED_SEEK_AFTER) {
+    _previous = _query.key;
+    _hasPrevious = true;
+  }
+  if (_pets.size() > PET_TRACKED_PAGE_SIZE) {
+    _next = BeastmasterTrackedKey::Of(_pets.back());
+    _pets.pop_back();
+    _hasNext = true;
+  }
+}
+
+bool BeastmasterTrackedPageBuilder::Has(uint32 entry) const {
+  return std::any_of(_pets.begin(), _pets.end(),
+                     [entry](auto const &pet) { return pet.entry == entry; });
+}
+
+void BeastmasterTrackedPageBuilder::Insert(BeastmasterTrackedPet const &pet) {
+  Remove(pet.entry);
+
+  auto key = BeastmasterTrackedKey::Of(pet);
+  if ((_previous && !_previous->IsBefore(key)) ||
+      (_next && !key.IsBefore(*_next)))
+    return; // Belongs on another page
+
+  auto it = std::find_if(_pets.begin(), _pets.end(), [&key](auto const &other) {
+    return key.IsBefore(BeastmasterTrackedKey::Of(other));
+  });
+  _pets.insert(it, pet);
+}
+
+void BeastmasterTrackedPageBuilder::Rename(uint32 entry,
+                                           std::string_view name) {
+  for (auto &pet : _pets)
+    if (pet.entry == entry)
+      pet.SetName(name);
+}
+
+void BeastmasterTrackedPageBuilder::Remove(uint32 entry) {
+  std::erase_if(_pets, [entry](auto const &pet) { return pet.entry == entry; });
+}
+
+BeastmasterTrackedPageInfo
+BeastmasterTrackedPageBuilder::Build(TrackedPetList &pets) {
+  // Inserted pets can overflow the page; the overflow stays reachable from
+  // the neighbouring page.
+  while (_pets.size() > PET_TRACKED_PAGE_SIZE) {
+    if (_query.seek == TRACKED_SEEK_BEFORE) {
+      _pets.erase(_pets.begin());
+      _hasPrevious = true;
+    } else {
+      _pets.pop_back();
+      _hasNext = true;
+    }
+  }
+
+  BeastmasterTrackedPageInfo info;
+  info.query = _query;
+  info.hasPrevious = _hasPrevious;
+  info.hasNext = _hasNext;
+  info.SetBounds(_pets);
+  pets = std::move(_pets);
+  return info;
+}
@@ -0,0 +1,128 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_TRACKED_PAGES_H_
+#define _BEASTMASTER_TRACKED_PAGES_H_
+
+#include "BeastmasterDefines.h"
+#include "BeastmasterGossipMenu.h"
+#include "BeastmasterTrackedPetsCache.h"
+#include <optional>
+#include <string_view>
+
+/**
+ * Position of a tracked pet in the menu. The menu lists the newest first
+ * and breaks ties on the higher entry, which is the (owner_guid, date_tamed,
+ * entry) index read backwards, so any page is one index seek and a LIMIT.
+ */
+struct BeastmasterTrackedKey {
+  time_t tamedAt = 0;
+  uint32 entry = 0;
+
+  static BeastmasterTrackedKey Of(BeastmasterTrackedPet const &pet) {
+    return {pet.tamedAt, pet.entry};
+  }
+
+  // True if this pet is listed before the other.
+  bool IsBefore(BeastmasterTrackedKey const &other) const {
+    return tamedAt != other.tamedAt ? tamedAt > other.tamedAt
+                                    : entry > other.entry;
+  }
+
+  bool operator==(BeastmasterTrackedKey const &) const = default;
+};
+
+enum BeastmasterTrackedSeek : uint8 {
+  TRACKED_SEEK_FIRST,  // The newest pets
+  TRACKED_SEEK_AFTER,  // The pets listed after the key
+  TRACKED_SEEK_BEFORE, // The pets listed before the key, queried oldest first
+  MAX_TRACKED_SEEKS
+};
+
+// Rows a page query asks for: one more than a page holds, which tells
+// whether there is another page past it.
+constexpr uint32 TRACKED_PAGE_QUERY_LIMIT = PET_TRACKED_PAGE_SIZE + 1;
+
+struct BeastmasterTrackedPageQuery {
+  BeastmasterTrackedSeek seek = TRACKED_SEEK_FIRST;
+  BeastmasterTrackedKey key; // Unused by TRACKED_SEEK_FIRST
+
+  bool operator==(BeastmasterTrackedPageQuery const &) const = default;
+};
+
+/**
+ * BeastmasterTrackedPageInfo
+ * Where a tracked pets page sits in the owner's list. Enough to move to the
+ * neighbouring pages without keeping the pets themselves.
+ */
+struct BeastmasterTrackedPageInfo {
+  BeastmasterTrackedPageQuery query; // The query that fetched the page
+  BeastmasterTrackedKey first;       // Entry 0 on an empty page
+  BeastmasterTrackedKey last;
+  bool hasPrevious = false;
+  bool hasNext = false;
+
+  BeastmasterTrackedPageQuery GetPrevious() const {
+    return {TRACKED_SEEK_BEFORE, first};
+  }
+
+  BeastmasterTrackedPageQuery GetNext() const {
+    return {TRACKED_SEEK_AFTER, last};
+  }
+
+  // The page again from its first pet on, e.g. once one was deleted.
+  BeastmasterTrackedPageQuery GetRefresh() const;
+
+  // Takes first and last from the pets now on the page.
+  void SetBounds(TrackedPetList const &pets);
+};
+
+/**
+ * BeastmasterTrackedPageBuilder
+ * Turns the rows of a page query into the page to show: puts them in menu
+ * order, applies the journaled writes the query may predate and trims the
+ * page to PET_TRACKED_PAGE_SIZE. A pet written after the query is placed
+ * only if it sorts between the neighbours of the page.
+ */
+class BeastmasterTrackedPageBuilder {
+public:
+  // Rows as the query returned them, at most TRACKED_PAGE_QUERY_LIMIT.
+  BeastmasterTrackedPageBuilder(BeastmasterTrackedPageQuery query,
+                                TrackedPetList rows);
+
+  bool Has(uint32 entry) const;
+
+  // Adds the pet, replacing a listed one with the same entry.
+  void Insert(BeastmasterTrackedPet const &pet);
+  void Rename(uint32 entry, std::string_view name);
+  void Remove(uint32 entry);
+
+  // Moves the finished page into pets.
+  BeastmasterTrackedPageInfo Build(TrackedPetList &pets);
+
+private:
+  BeastmasterTrackedPageQuery _query;
+  TrackedPetList _pets; // Menu order
+  // Nearest pets off the page, when the query saw them.
+  std::optional<BeastmasterTrackedKey> _previous;
+  std::optional<BeastmasterTrackedKey> _next;
+  bool _hasPrevious = false;
+  bool _hasNext = false;
+};
+
+#endif // _BEASTMASTER_TRACKED_PAGES_H_
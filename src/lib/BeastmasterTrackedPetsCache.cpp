@@ -0,0 +1,150 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but without
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BeastmasterTrackedPetsCache.h"
+#include <algorithm>
+#include <cstring>
+
+void BeastmasterTrackedPet::SetName(std::string_view name) {
+  std::size_t length = std::min(name.size(), MAX_NAME_LENGTH);
+  // Don't split a UTF-8 sequence: back up over continuation bytes.
+  if (length < name.size())
+    while (length > 0 && (uint8(name[length]) & 0xC0) == 0x80)
+      --length;
+  std::memcpy(_name, name.data(), length);
+  _nameLength = uint8(length);
+}
+
+void BeastmasterTrackedPetsCache::SetBudget(std::size_t bytes) {
+  _shardBudget.store(bytes / SHARD_COUNT, std::memory_order_relaxed);
+  for (Shard &shard : _shards) {
+    std::lock_guard<BeastmasterMutex> lock(shard.lock);
+    Trim(shard);
+  }
+}
+
+bool BeastmasterTrackedPetsCache::Get(uint64 guid, TrackedPetList &pets) {
+  Shard &shard = GetShard(guid);
+  std::lock_guard<BeastmasterMutex> lock(shard.lock);
+  auto it = shard.index.find(guid);
+  if (it == shard.index.end()) {
+    _misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+  pets = it->second->pets;
+  _hits.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void BeastmasterTrackedPetsCache::Put(uint64 guid, TrackedPetList pets) {
+  pets.shrink_to_fit();
+  std::size_t bytes = GetNodeBytes(pets);
+
+  Shard &shard = GetShard(guid);
+  std::lock_guard<BeastmasterMutex> lock(shard.lock);
+  auto it = shard.index.find(guid);
+  if (it != shard.index.end()) {
+    RemoveBytes(shard, it->second->bytes);
+    _lists.fetch_sub(1, std::memory_order_relaxed);
+    shard.lru.erase(it->second);
+    shard.index.erase(it);
+  }
+
+  if (bytes > _shardBudget.load(std::memory_order_relaxed))
+    return; // Doesn't fit, or the cache is disabled.
+
+  shard.lru.push_front(Node{guid, std::move(pets), bytes});
+  shard.index.emplace(guid, shard.lru.begin());
+  AddBytes(shard, bytes);
+  _lists.fetch_add(1, std::memory_order_relaxed);
+  Trim(shard);
+}
+
+void BeastmasterTrackedPetsCache::Erase(uint64 guid) {
+  Shard &shard = GetShard(guid);
+  std::lock_guard<BeastmasterMutex> lock(shard.lock);
+  auto it = shard.index.find(guid);
+  if (it == shard.index.end())
+    return;
+  RemoveBytes(shard, it->second->bytes);
+  _lists.fetch_sub(1, std::memory_order_relaxed);
+  shard.lru.erase(it->second);
+  shard.index.erase(it);
+}
+
+void BeastmasterTrackedPetsCache::Modify(
+    uint64 guid, std::function<void(TrackedPetList &)> const &fn) {
+  Shard &shard = GetShard(guid);
+  std::lock_guard<BeastmasterMutex> lock(shard.lock);
+  auto it = shard.index.find(guid);
+  if (it == shard.index.end())
+    return;
+
+  Node &node = *it->second;
+  fn(node.pets);
+  RemoveBytes(shard, node.bytes);
+  node.bytes = GetNodeBytes(node.pets);
+  AddBytes(shard, node.bytes);
+  Trim(shard);
+}
+
+BeastmasterTrackedPetsCache::Stats
+BeastmasterTrackedPetsCache::GetStats() const {
+  Stats stats{};
+  stats.hits = _hits.load(std::memory_order_relaxed);
+  stats.misses = _misses.load(std::memory_order_relaxed);
+  stats.evictions = _evictions.load(std::memory_order_relaxed);
+  stats.budget = _shardBudget.load(std::memory_order_relaxed) * SHARD_COUNT;
+  // Each total is exact, but the two may be from slightly different moments.
+  stats.lists = _lists.load(std::memory_order_relaxed);
+  stats.bytes = _bytes.load(std::memory_order_relaxed);
+  return stats;
+}
+
+/*static*/ std::size_t
+BeastmasterTrackedPetsCache::GetNodeBytes(TrackedPetList const &pets) {
+  // List node (two links), index node and bucket, and the records.
+  return sizeof(Node) + 2 * sizeof(void *) +
+         sizeof(std::pair<uint64 const, void *>) + 2 * sizeof(void *) +
+         pets.capacity() * sizeof(BeastmasterTrackedPet);
+}
+
+void BeastmasterTrackedPetsCache::AddBytes(Shard &shard, std::size_t bytes) {
+  shard.bytes += bytes;
+  _bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void BeastmasterTrackedPetsCache::RemoveBytes(Shard &shard,
+                                              std::size_t bytes) {
+  shard.bytes -= bytes;
+  _bytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void BeastmasterTrackedPetsCache::Trim(Shard &shard) {
+  std::size_t budget = _shardBudget.load(std::memory_order_relaxed);
+  while (shard.bytes > budget && !shard.lru.empty()) {
+    Node &node = shard.lru.back();
+    RemoveBytes(shard, node.bytes);
+    _lists.fetch_sub(1, std::memory_order_relaxed);
+    shard.index.erase(node.guid);
+    shard.lru.pop_back();
+    _evictions.fetch_add(1, std::memory_order_relaxed);
+  }
+}
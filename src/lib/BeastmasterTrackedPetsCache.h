@@ -0,0 +1,140 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright
+ * information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BEASTMASTER_TRACKED_PETS_CACHE_H_
+#define _BEASTMASTER_TRACKED_PETS_CACHE_H_
+
+#include "BeastmasterDefines.h"
+#include "BeastmasterMutex.h"
+#include "BeastmasterNameValidator.h"
+#include <array>
+#include <atomic>
+#include <ctime>
+#include <functional>
+#include <list>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * BeastmasterTrackedPet
+ * One tracked pet as cached for the menu. Fixed size, with the name stored
+ * inline in room for any name the validator accepts; longer names, which
+ * can only come from the database, are cut at a character boundary.
+ */
+struct BeastmasterTrackedPet {
+  static constexpr std::size_t MAX_NAME_LENGTH =
+      BeastmasterNameValidator::MAX_BYTES;
+
+  BeastmasterTrackedPet() = default;
+  BeastmasterTrackedPet(uint32 entry, std::string_view name, time_t tamedAt)
+      : tamedAt(tamedAt), entry(entry) {
+    SetName(name);
+  }
+
+  std::string_view GetName() const { return {_name, _nameLength}; }
+  void SetName(std::string_view name);
+
+  time_t tamedAt = 0;
+  uint32 entry = 0;
+
+private:
+  uint8 _nameLength = 0;
+  char _name[MAX_NAME_LENGTH];
+};
+
+// Tracked pets of one player, newest first.
+using TrackedPetList = std::vector<BeastmasterTrackedPet>;
+
+/**
+ * BeastmasterTrackedPetsCache
+ * Tracked pet lists by player, in a size-capped LRU split into lock-striped
+ * shards. Each shard evicts its least recently used lists once it exceeds
+ * its share of the memory budget.
+ *
+ * Lists are copied in and out, so no reference into a shard outlives its
+ * lock. Thread-safe; GetStats() takes no lock, so it is cheap to poll.
+ */
+class BeastmasterTrackedPetsCache {
+public:
+  struct Stats {
+    uint64 hits;
+    uint64 misses;
+    uint64 evictions;
+    std::size_t lists;
+    std::size_t bytes;
+    std::size_t budget;
+  };
+
+  // Budget in bytes for all shards together; 0 disables the cache.
+  void SetBudget(std::size_t bytes);
+
+  // Copies the cached list of the player; false on a miss.
+  bool Get(uint64 guid, TrackedPetList &pets);
+
+  void Put(uint64 guid, TrackedPetList pets);
+  void Erase(uint64 guid);
+
+  // Edits the cached list of the player in place, if there is one.
+  void Modify(uint64 guid, std::function<void(TrackedPetList &)> const &fn);
+
+  Stats GetStats() const;
+
+private:
+  static constexpr std::size_t SHARD_COUNT = 16;
+
+  struct Node {
+    uint64 guid;
+    TrackedPetList pets;
+    std::size_t bytes;
+  };
+
+  struct Shard {
+    mutable BeastmasterMutex lock{LOCK_SITE_TRACKED_PETS_CACHE};
+    std::list<Node> lru; // Most recently used first
+    std::unordered_map<uint64, std::list<Node>::iterator> index;
+    std::size_t bytes = 0;
+  };
+
+  Shard &GetShard(uint64 guid) {
+    // Low guid bits are sequential, so mix before picking a shard.
+    return _shards[(guid * 0x9E3779B97F4A7C15ull) >> 60];
+  }
+
+  static std::size_t GetNodeBytes(TrackedPetList const &pets);
+
+  // Keep shard.bytes and the totals in step. Lock held.
+  void AddBytes(Shard &shard, std::size_t bytes);
+  void RemoveBytes(Shard &shard, std::size_t bytes);
+
+  // Drops least recently used lists until the shard fits. Lock held.
+  void Trim(Shard &shard);
+
+  std::array<Shard, SHARD_COUNT> _shards;
+  std::atomic<std::size_t> _shardBudget{0};
+
+  // Totals over all shards, updated under the shard locks but read without.
+  std::atomic<std::size_t> _lists{0};
+  std::atomic<std::size_t> _bytes{0};
+
+  std::atomic<uint64> _hits{0};
+  std::atomic<uint64> _misses{0};
+  std::atomic<uint64> _evictions{0};
+};
+
+#endif // _BEASTMASTER_TRACKED_PETS_CACHE_H_